@@ -8,6 +8,7 @@
 
 #include <Arduino.h>
 #include <stdlib.h>                         // used for `atoi()` function to read from serial.
+#include "SerialCLI.h"                      // lib/SerialCLI: line assembly & dispatch
 
 /* Set ESP32 to use only core #1 in this demonstration */
 
@@ -20,6 +21,7 @@
 static const uint8_t buf_len = 20;          // Buffer length setting for user input to serial terminal
 static const int led_pin = LED_BUILTIN;     // Pin 13 for on-board LED.
 static int led_delay = 500;                 // 500ms initial delay: changes with user input.
+static SerialCLI<buf_len, 0> cli;           // Default handler only
 
 // 1st Task: blink LED on pin 13 at a rate set by a global variable
 void toggleLED(void *parameter)             // Function Definition for Task 1
@@ -35,36 +37,24 @@ void toggleLED(void *parameter)             // Function Definition for Task 1
 
 // 2nd Task: Read user input from Serial Terminal with `atoi()` function.
 // Note that for Arduino Framework, `Serial.readString()` or `Serial.parseInt()` are also valid.
+void setDelay(const char *line)             // Every line entered is a new delay value
+{
+    led_delay = atoi(line);
+    Serial.print("New LED Delay = ");
+    Serial.print(led_delay);
+    Serial.println("ms");
+}
+
 void readSerial(void *parameters)           // Function Definition for Task 2
 {
-    char input;                             // Each Character Input
-    char buf[buf_len];                      // Array to hold user input characters
-    uint8_t index = 0;                      // Number of characters entered by user.
-    memset(buf, 0, buf_len);                // Clear the buffer 1st
+    cli.setDefault(setDelay);               // No named commands: any line is a number
+    cli.setEcho(false);
+    cli.begin(Serial, Serial);
 
     for(;;)
     {
-        if(Serial.available() > 0)          // Check If Serial Terminal is open.
-        {
-            input = Serial.read();          // Read user input from serial terminal
-            if(input == '\n')               // Update delay only if Enter key is pressed.
-            {
-                led_delay = atoi(buf);
-                Serial.print("New LED Delay = ");
-                Serial.print(led_delay);
-                Serial.println("ms");
-                memset(buf, 0, buf_len);    // Clear buffer after user input read.
-                index = 0;                  // Reset index
-            }
-            else
-            {
-                if(index < buf_len - 1)     // Only append if index < message limit.
-                {
-                    buf[index] = input;
-                    index++;
-                }
-            }
-        }
+        cli.poll();                         // Update delay only when Enter key is pressed.
+        vTaskDelay(20 / portTICK_PERIOD_MS);
     }
 }
 
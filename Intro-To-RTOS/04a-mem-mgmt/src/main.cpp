@@ -6,6 +6,7 @@
  */
 
 #include <Arduino.h>
+#include "SerialCLI.h"                                     // lib/SerialCLI: line assembly & dispatch
 
 #if CONFIG_FREERTOS_UNICORE                                 // Use Core 1 only.
     static const BaseType_t app_cpu = 0;
@@ -16,43 +17,31 @@
 static const uint8_t buf_len = 255;                         // 8 bit unsigned for buffer
 static char *msg_ptr = NULL;                                // Pointer to user message
 static volatile uint8_t msg_flag = 0;                       // flag sets to 1 when message is completed.
+static SerialCLI<buf_len, 0> cli;                           // Default handler only
 
-void readSerialTask(void *param)
+void storeMessage(const char *line)                          // Called by `cli` when user hits Enter key
 {
-    char user;                                              // each user entered character
-    char buffer[buf_len];                                   // buffer for user entered string
-    uint8_t index = 0;                                      // index represents string length.
+    if(msg_flag == 0)
+    {
+        size_t len = strlen(line) + 1;                      // Include the NULL terminator
+        msg_ptr = (char *)pvPortMalloc(len * sizeof(char)); // allocate memory for message
+        configASSERT(msg_ptr);                              // throw error & reset if memory full.
+        memcpy(msg_ptr, line, len);                         // Copy message to newly allocated memory
+        msg_flag = 1;                                       // Notify other task that message is ready
+    }
+}
 
-    memset(buffer, 0, buf_len);                             // clear the buffer 1st
+void readSerialTask(void *param)
+{
+    cli.setDefault(storeMessage);                           // Every line is a message
+    cli.setEcho(false);
+    cli.begin(Serial, Serial);
     Serial.println("Enter a string to print to the terminal: ");
 
     for(;;)
     {
-        if(Serial.available() > 0)
-        {
-            user = Serial.read();                           // Read each character entered by user
-
-            if(index < (buf_len - 1))                       // if buffer is not over the limit
-            {
-                buffer[index] = user;                       // Add user entered string to array
-                index++;
-            }
-
-            if(user == '\n')                                // When user hits Enter key
-            {
-                buffer[index - 1] = '\0';                   // NULL terminate string
-
-                if(msg_flag == 0)
-                {
-                    msg_ptr = (char *)pvPortMalloc(index * sizeof(char));   // allocate memory for message
-                    configASSERT(msg_ptr);                  // throw error & reset if memory full.
-                    memcpy(msg_ptr, buffer, index);         // Copy message to newly allocated memory
-                    msg_flag = 1;                           // Notify other task that message is ready
-                }
-                memset(buffer, 0, buf_len);                 // Reset buffer & index counter.
-                index = 0;                                  // Reset index.
-            }
-        }
+        cli.poll();                                         // Read each character entered by user
+        vTaskDelay(20 / portTICK_PERIOD_MS);
     }
 }
 
@@ -9,6 +9,8 @@
  */
 
 #include <Arduino.h>
+#include "SerialCLI.h"                                              // lib/SerialCLI: line assembly, echo & dispatch
+#include "WaitSet.h"                                                // lib/WaitSet: block on serial RX & msg_queue together
 
 #if CONFIG_FREERTOS_UNICORE                                         // Use Core 1 only.
     static const BaseType_t app_cpu = 0;
@@ -31,67 +33,58 @@ struct Message
 
 static QueueHandle_t delay_queue;                                   // Declare queues for messages & delay
 static QueueHandle_t msg_queue;
+static SerialCLI<buffer_len, 1> cli;                                // 1 command: `delay `
+static WaitSet<1> events;                                           // Wakes the CLI task: msg_queue or serial RX
+
+void delayCommand(const char *args)                                  // "delay xxx": `args` points at xxx
+{
+    int led_delay = atoi(args);                                     // retreive integer value at end of string
+    led_delay = abs(led_delay);                                     // led_delay can't be negative
+
+    if(xQueueSend(delay_queue, (void *)&led_delay, 10) != pdTRUE)   // Send to delay_queue & evaluate
+    {
+        Serial.println("ERROR: Could Not Put Item In Delay Queue!");
+    }
+}
+
+void echoMessage(const char *line)                                  // Any other line is echoed via msg_queue
+{
+    Message received_msg;
+    Serial.print("User Entered: ");
+    snprintf(received_msg.body, sizeof(received_msg.body), "%s", line); // Truncate: `body` is only 20 chars
+    received_msg.count = strlen(line);                              // Print # of characters in message
+    xQueueSend(msg_queue, (void *)&received_msg, 10);               // Send to msg_queue
+}
 
 void userCommandTask(void *param)                                   // Function definition for user CLI task
 {
     Message received_msg;                                           // object declaration for user message
-    char input;                                                 
-    char buffer[buffer_len];                                        // buffer to hold user input
-    int led_delay;                                                  // blink delay in milliseconds
-    uint8_t index = 0;
-    uint8_t command_len = strlen(command);
 
-    memset(buffer, 0, buffer_len);                                  // Clear user input buffer
+    cli.add(command, delayCommand);                                 // If 1st 6 characters are 'delay '
+    cli.setDefault(echoMessage);
+    cli.begin(Serial, Serial);                                      // echo each character back to the serial terminal
+
+    QueueHandle_t queue;
+    cli.poll();                                                     // Anything typed before `onReceive()` was hooked up
 
     for(;;)
     {
-        if(xQueueReceive(msg_queue, (void *)&received_msg, 0) == pdTRUE) // If message in queue
+        WaitSet<1>::Event event = events.wait(queue);               // Sleep until there is something to do
+        if(event == events.EV_QUEUE && xQueueReceive(queue, (void *)&received_msg, 0) == pdTRUE)
         {
             Serial.print(received_msg.body);                        // print message body
             Serial.println(received_msg.count);                     // print message integer value
         }
-        
-        if(Serial.available() > 0)
+        else if(event == events.EV_SERIAL)
+        {
+            cli.poll();                                             // Read, echo & dispatch user input
+        }
+        else if(event == events.EV_SHUTDOWN)
         {
-            input = Serial.read();                                  // read each character of user input
-
-            if(index < (buffer_len - 1))
-            {
-                buffer[index] = input;                              // write received character to buffer
-                index++;
-            }
-
-            if(input == '\n')                                       // Check when user presses ENTER key
-            {
-                Serial.print("\n");
-                
-                if(memcmp(buffer, command, command_len) == 0)       // If 1st 6 characters are 'delay'
-                {                                                   // Ref: https://cplusplus.com/reference/cstring/memcmp/
-                    char* tail = buffer + command_len;              // declare & move a pointer to the integer value at the end of the buffer string
-                    led_delay = atoi(tail);                         // retreive integer value at end of string
-                    led_delay = abs(led_delay);                     // led_delay can't be negative
-
-                    if(xQueueSend(delay_queue, (void *)&led_delay, 10) != pdTRUE) // Send to delay_queue & evaluate
-                    {
-                        Serial.println("ERROR: Could Not Put Item In Delay Queue!");
-                    }
-                } 
-                else
-                {
-                    Serial.print("User Entered: ");
-                    strcpy(received_msg.body, buffer);              // Print user message to terminal
-                    received_msg.count = index;                     // Print # of characters in message
-                    xQueueSend(msg_queue, (void *)&received_msg, 10);   // Send to msg_queue
-                }
-                memset(buffer, 0, buffer_len);                      // Clear input buffer
-                index = 0;                                          // Reset index counter.
-            }
-            else // echo each character back to the serial terminal
-            {
-                Serial.print(input);
-            }
+            break;
         }
     }
+    vTaskDelete(NULL);
 }
 
 void blinkLEDTask(void *param)
@@ -139,6 +132,14 @@ void setup()
     delay_queue = xQueueCreate(delay_queue_len, sizeof(int));       // Instantiate queue objects.
     msg_queue = xQueueCreate(msg_queue_len, sizeof(Message));
 
+    events.addQueue(msg_queue, msg_queue_len);                      // Queues must be empty when they join the set
+    events.addSerial(Serial);                                       // Serial RX wakes the CLI task instead of polling
+    if(!events.begin())
+    {
+        Serial.println("ERROR: Could Not Create Queue Set!");
+        ESP.restart();
+    }
+
     xTaskCreatePinnedToCore(                                        // Task read user input
         userCommandTask,
         "User CLI Terminal",
@@ -8,6 +8,7 @@
  */
 
 #include <Arduino.h>
+#include "SerialCLI.h"                                                  // lib/SerialCLI: line assembly & echo
 //#include <timers.h>                                                   // Only for Vanilla FreeRTOS         
 
 #if CONFIG_FREERTOS_UNICORE
@@ -19,6 +20,7 @@
 static const TickType_t dimmerDelay = 5000 / portTICK_PERIOD_MS;        // LED on for 5 seconds
 static const int ledPin = LED_BUILTIN;                                  // Assign LED to pin 13
 static TimerHandle_t oneShotTimer = NULL;                               // Declare one-shot timer                   
+static SerialCLI<64, 0> cli;                                            // Echo only: no commands yet
 
 void autoDimmerCallback(TimerHandle_t xTimer);                          // Callback Functions
 void userCLI(void *parameters);
@@ -59,18 +61,16 @@ void autoDimmerCallback(TimerHandle_t xTimer)
 
 void userCLI(void *parameters)
 {
-    char input;                                                         // each user input character
     pinMode(ledPin, OUTPUT);                                            // Configure LED as output
+    cli.begin(Serial, Serial);                                          // No commands: only echoes input back to Terminal
 
     for(;;)
     {
-        if (Serial.available() > 0)                                     // Check if serial terminal available
+        if(cli.poll() > 0)                                              // Any keypress counts as activity
         {
-            input = Serial.read();
-            Serial.print(input);                                        // echo everythin back to Termnal
-
             digitalWrite(ledPin, HIGH);                                 // Turn on LED
             xTimerStart(oneShotTimer, portMAX_DELAY);                   // Start countdown. If timer is already running, this works like xTimerReset()
-       }
+        }
+        vTaskDelay(20 / portTICK_PERIOD_MS);
     }
 }
\ No newline at end of file
@@ -10,6 +10,8 @@
  */
 
 #include <Arduino.h>
+#include "SerialCLI.h"                                          // lib/SerialCLI: line assembly, echo & dispatch
+#include "WaitSet.h"                                            // lib/WaitSet: block on serial RX & msgQueue together
 //#include <semphr.h>                                           // Only for Vanill FreeRTOS
 
 #if CONFIG_FREERTOS_UNICORE
@@ -26,7 +28,6 @@ enum { CMD_BUF_LEN = 255 };                                     // Max char in C
 static const char termCommand[] = "avg";                        // Terminal Command to display Average ADC value
 static const uint16_t timerDivider = 8;                         // Timer counts at 10MHz
 static const uint64_t timerMaxCount = 1000000;                  // 0.1 sec @ 10MHz
-static const uint32_t CLIdelay = 25;                            // delay for printing user CLI messages & for task yielding
 static const int ADCpin = A0;                                   // A0 = ADC2_CH0: GPIO 26 on ESP32
 
 static portMUX_TYPE spinlock = portMUX_INITIALIZER_UNLOCKED;    // Declare spinlock mutex for ISR critical section
@@ -34,6 +35,8 @@ static hw_timer_t *timer = NULL;                                // Delare ESP32
 static TaskHandle_t processingTask = NULL;                      // Declare Task Notification for ADC ISR
 static SemaphoreHandle_t semDoneReading = NULL;                 // Declare Semaphore for when ADC is done being read
 static QueueHandle_t msgQueue;                                  // Declare queue for CLI messages
+static SerialCLI<CMD_BUF_LEN, 1> cli;                           // 1 command: `avg`
+static WaitSet<1> events;                                       // Wakes the CLI task: msgQueue or serial RX
 
 static volatile uint16_t buf0[BUF_LEN];                         // 1st Buffer for ADC values
 static volatile uint16_t buf1[BUF_LEN];                         // 2nd Buffer for ADC values
@@ -86,60 +89,48 @@ void IRAM_ATTR ISRtimer()                                       // ISR function
     //portYIELD_FROM_ISR(taskWoken);                                            // Vanilla FreeRTOS
 }
 
+void avgCommand(const char *args)                               // `avg`: print the latest average
+{
+    Serial.print("Average ADC Value: ");
+    Serial.println(ADCavg);                                     // print ADC average value
+}
+
+void echoMessage(const char *line)                              // Any other line is echoed back to the Terminal
+{
+    Message rxMsg;
+    Serial.print("User Entered: ");
+    snprintf(rxMsg.msgBody, MSG_LEN, "%s", line);               // Truncate: CLI lines can be longer than `msgBody`
+    xQueueSend(msgQueue, (void *)&rxMsg, 10);                   // Send to msg_queue
+}
+
 void userCLI(void *param)
 {
     Message rxMsg;                                              // struct for error messages
-    char input;
-    char commandBuf[CMD_BUF_LEN];                               // create 255 char buffer
-    uint8_t index = 0;
-    uint8_t cmdLen = strlen(termCommand);                       // cmdLen for "avg" command = 3
 
-    memset(commandBuf, 0, CMD_BUF_LEN);                         // Clear the user CLI buffer
+    cli.add(termCommand, avgCommand);                           // If User Enters "avg" into CLI
+    cli.setDefault(echoMessage);
+    cli.begin(Serial, Serial);                                  // Echo user entered characters to the Terminal
     
+    QueueHandle_t queue;
+    cli.poll();                                                 // Anything typed before `onReceive()` was hooked up
+
     for(;;)
     {
-        if(xQueueReceive(msgQueue, (void *)&rxMsg, 0) == pdTRUE)// Check for any messages in Queue
+        WaitSet<1>::Event event = events.wait(queue);           // Sleep until there is something to do
+        if(event == events.EV_QUEUE && xQueueReceive(queue, (void *)&rxMsg, 0) == pdTRUE)
         {
             Serial.println(rxMsg.msgBody);                      // print any messages to Terminal
         }
-
-        if(Serial.available() > 0)
+        else if(event == events.EV_SERIAL)
         {
-            input = Serial.read();                              // Read characters from terminal
-            
-            if(index < CMD_BUF_LEN - 1)                         // if buffer is not full (255 char)
-            {
-                commandBuf[index++] = input;                    // Store characters in buffer
-            }
-
-            if(input == '\n')                                   // When user presses enter key
-            {
-                Serial.print("\n");                             // print newline in Terminal
-                
-                commandBuf[index - 1] = '\0';                   // NULL terminate buffer string
-                
-                //if(strcmp(commandBuf, termCommand) == 0)      // DIDNT WORK. REF: https://cplusplus.com/reference/cstring/strcmp/
-                if(memcmp(commandBuf, termCommand, cmdLen) == 0)// If User Enters "avg" into CLI: If no characters differ (strings are equal)
-                {
-                    Serial.print("Average ADC Value: ");        // REF: https://cplusplus.com/reference/cstring/memcmp/
-                    Serial.println(ADCavg);                     // print ADC average value
-                }
-                else                                            // Echo user message to the Terminal
-                {
-                    Serial.print("User Entered: ");
-                    strcpy(rxMsg.msgBody, commandBuf);          // Print user message to terminal
-                    xQueueSend(msgQueue, (void *)&rxMsg, 10);   // Send to msg_queue
-                }
-                memset(commandBuf, 0, CMD_BUF_LEN);             // Clear the buffer
-                index = 0;                                      // Reset index
-            }
-            else // if(input != '\n')
-            {
-                Serial.print(input);                            // Echo user entered characters to the Terminal
-            }
+            cli.poll();                                         // Read, echo & dispatch everything received
+        }
+        else if(event == events.EV_SHUTDOWN)
+        {
+            break;
         }
-        vTaskDelay(CLIdelay / portTICK_PERIOD_MS);              // Yield to other tasks (25ms) to prevent starving
     }
+    vTaskDelete(NULL);
 }
 
 void calcAvg(void *param)
@@ -195,12 +186,22 @@ void setup()
     vTaskDelay(1000 / portTICK_PERIOD_MS);
     Serial.println("\n=>> FreeRTOS ADC Sample & Average Demo w/ CLI <<=");
 
+    events.addQueue(msgQueue, MSG_QUEUE_LEN);                   // Queues must be empty when they join the set
+    events.addSerial(Serial);                                   // Serial RX wakes the CLI task instead of polling
+    if(!events.begin())
+    {
+        Serial.println("ERROR: COULD NOT INSTANTIATE QUEUE SET");
+        Serial.println("RESTARTING....");
+        vTaskDelay(1000 / portTICK_PERIOD_MS);
+        ESP.restart();
+    }
+
     xTaskCreatePinnedToCore(                                    // Instatiate task to handle the user CLI
         userCLI,
         "User CLI Terminal",
         1536,
         NULL,
-        2,                                                      // Higher Priority, but only runs every 20ms
+        2,                                                      // Higher Priority, but only runs on input or messages
         NULL,
         app_cpu
     );
@@ -2,23 +2,42 @@
  * Joel Brigida
  * May 29, 2023
  * This demo program uses a Hardware ISR to sample the ADC value at 16kHz and add that value
- * to a buffer. After the buffer has 1600 values, Task A wakes up, computes the average & RMS, which
- * is a global floating point variable. Task B handles the Serial Terminal.
- * When the user enters "rms" into the serial terminal, the latest RMS value
+ * to a buffer. After the buffer has 256 values (16ms), Task A wakes up, computes the average, RMS
+ * & 3 spectrum bands (Goertzel: bass, mid, treble) & publishes them in a `SeqLock` snapshot.
+ * Task B handles the Serial Terminal.
+ * Task C runs on the other core & renders the RGB LED (or a strip, `-D NUM_LEDS=60`) at 62.5 fps:
+ * loudness sets brightness, the band balance sets hue (bass = red, mid = green, treble = blue),
+ * with a fast attack & slow decay. It only reads the snapshot, so neither side ever waits.
+ * When the user enters "rms" into the serial terminal, the latest RMS value & bands
  * of the ADC will be output. Any other message entered into the serial terminal will just
  * be echoed back to the terminal.
  */
 
 #include <Arduino.h>
+#include <FastLED.h>                                                // For RGB LED
+#include "SerialCLI.h"                                              // lib/SerialCLI: line assembly, echo & dispatch
+#include "WaitSet.h"                                                // lib/WaitSet: block on serial RX & msgQueue together
+#include "SeqLock.h"                                                // lib/SeqLock: sampler -> renderer snapshot
+#include "LedTables.h"                                              // lib/LedTables: hue wheel
 //#include <semphr.h>                                               // Only for Vanilla FreeRTOS
 
 #if CONFIG_FREERTOS_UNICORE
     static const BaseType_t app_cpu = 0;
+    static const BaseType_t pro_cpu = 0;
 #else
     static const BaseType_t app_cpu = 1;
+    static const BaseType_t pro_cpu = 0;                            // Renderer: away from the 16kHz ISR
 #endif
 
-enum { BUF_LEN = 1600 };                                            // # elements for ADC samples
+#define RGB_LED 2                                                   // Pin 2 on Thing Plus C is connected to WS2812 LED
+#define COLOR_ORDER GRB
+#define CHIPSET WS2812
+#ifndef NUM_LEDS
+#define NUM_LEDS 1                                                  // Only 1 RGB LED on the ESP32 Thing Plus: level meter on a strip
+#endif
+
+enum { BUF_LEN = 256 };                                             // # elements for ADC samples: 16ms @ 16kHz
+enum { NUM_BANDS = 3 };                                             // Bass, mid, treble
 enum { MSG_LEN = 100 };                                             // Max characters in struct message body
 enum { MSG_QUEUE_LEN = 5 };                                         // 5 elements in message queue
 enum { CMD_BUF_LEN = 255 };                                         // Max char in CLI command
@@ -26,11 +45,16 @@ enum { CMD_BUF_LEN = 255 };                                         // Max char
 static const char termCommand[] = "rms";                            // Terminal command to display RMS ADC value
 static const uint16_t timerDivider = 2;                             // Timer counts at 40MHz
 static const uint64_t timerMaxCount = 2500;                         // 40MHz / 2500 = 16kHz sample rate
-static const uint32_t CLIdelay = 10;                                // 10ms dalay for printing user CLI messages & for task yielding
 static const uint16_t ADCmax = 4095;                                // Max ADC value (12-bit)
 static const uint8_t PWMch = 0;                                     // PWM channel: GPIO0, ADC2_CH1, Pin 25, CLK_OUT1
 static const float ADCvoltage = 3.3;                                // Max ADC voltage = 3.3v
-static float ADCrms;                                                // Calculated RMS value for 10 ADC samples
+static const float SampleHz = 16000.0;
+static const float bandHz[NUM_BANDS] = { 150.0, 1000.0, 4000.0 };   // Goertzel bin centers (62.5Hz apart @ 256 samples)
+static const float LevelFullScale = 0.5;                            // RMS volts for full brightness
+static const float AttackSec = 0.015;                               // Brightness rises this fast...
+static const float DecaySec = 0.250;                                // ...& falls this slowly
+static const float HueSec = 0.100;
+static const uint32_t FrameMs = 16;                                 // Renderer: 62.5 fps
 
 static const int ADCpin = A0;                                       // A0 = ADC2_CH0: GPIO 26 on ESP32
 static const int LEDpin = LED_BUILTIN;                              // Assign on-board LED to pin 13
@@ -40,6 +64,8 @@ static hw_timer_t *timer = NULL;                                    // Delare ES
 static TaskHandle_t processingTask = NULL;                          // Declare Task Notification for ADC ISR
 static SemaphoreHandle_t semDoneReading = NULL;                     // Declare Semaphore for when ADC is done being read
 static QueueHandle_t msgQueue;                                      // Declare queue for CLI messages
+static SerialCLI<CMD_BUF_LEN, 1> cli;                               // 1 command: `rms`
+static WaitSet<1> events;                                           // Wakes the CLI task: msgQueue or serial RX
 
 static volatile uint16_t buf0[BUF_LEN];                             // 1st Buffer for ADC values
 static volatile uint16_t buf1[BUF_LEN];                             // 2nd Buffer for ADC values
@@ -47,6 +73,17 @@ static volatile uint16_t *writeTo = buf0;                           // pointer t
 static volatile uint16_t *readFrom = buf1;                          // pointer to buffer buf1
 static volatile uint8_t bufOverrun = 0;                             // Flag for Double buffer overrun
 
+struct AudioLevel                                                   // Published by `calcRMS` after every block
+{
+    float rms;                                                      // Volts, DC removed
+    float bands[NUM_BANDS];                                         // Amplitude in volts per band
+    uint32_t blocks;                                                // Blocks processed so far
+};
+
+static SeqLock<AudioLevel> audio(AudioLevel{});                     // Newest block wins: the renderer never waits
+static CRGB leds[NUM_LEDS];
+static volatile uint32_t framesRendered = 0;
+
 struct Message
 {
     char msgBody[MSG_LEN];                                          // Queue elements for CLI messages
@@ -56,6 +93,7 @@ void IRAM_ATTR swap();                                              // Called fr
 void IRAM_ATTR ISRtimer();                                          // Timer function stored in RAM
 void userCLI(void *param);                                          // Function for Serial Terminal CLI
 void calcRMS(void *param);                                          // Calculate RMS of 10 ADC values
+void renderLEDs(void *param);                                       // Audio level -> RGB LED, other core
 
 void setup()
 {
@@ -66,6 +104,9 @@ void setup()
     ledcAttachPin(LEDpin, PWMch);                                   // Assign LED to PWM channel 0
     ledcSetup(PWMch, 4000, 16);                                     // Channel 0, 12kHz, 16-bit resolution
 
+    FastLED.addLeds <CHIPSET, RGB_LED, COLOR_ORDER> (leds, NUM_LEDS).setCorrection(TypicalLEDStrip);
+    FastLED.setBrightness(75);
+
     Serial.begin(115200);
     vTaskDelay(1000 / portTICK_PERIOD_MS);
     Serial.println("\n=>> FreeRTOS ADC RMS Audio Sample & Process Demo w/ CLI <<=");
@@ -80,12 +121,22 @@ void setup()
     
     xSemaphoreGive(semDoneReading);                                 // Initialize the 'Done Reading' semaphore to 1
 
+    events.addQueue(msgQueue, MSG_QUEUE_LEN);                       // Queues must be empty when they join the set
+    events.addSerial(Serial);                                       // Serial RX wakes the CLI task instead of polling
+    if(!events.begin())
+    {
+        Serial.println("ERROR: COULD NOT INSTANTIATE QUEUE SET");
+        Serial.println("RESTARTING....");
+        vTaskDelay(1000 / portTICK_PERIOD_MS);
+        ESP.restart();
+    }
+
     xTaskCreatePinnedToCore(                                        // Instatiate task to handle the user CLI
         userCLI,
         "User CLI Terminal",
         1536,
         NULL,
-        2,                                                          // Higher Priority, but only runs every 20ms
+        2,                                                          // Higher Priority, but only runs on input or messages
         NULL,
         app_cpu
     );
@@ -100,6 +151,16 @@ void setup()
         app_cpu
     );
 
+    xTaskCreatePinnedToCore(                                        // Instatiate task for the RGB LED
+        renderLEDs,
+        "Render LEDs",
+        2048,
+        NULL,
+        1,
+        NULL,
+        pro_cpu
+    );
+
     timer = timerBegin(0, timerDivider, true);                      // instantiate 100ms timer for ISR: (Start Value, divider, Count Up)
     timerAttachInterrupt(timer, &ISRtimer, true);                   // Attach timer to ISR: (timer, function, Rising Edge)
     timerAlarmWrite(timer, timerMaxCount, true);                    // Attach ISR trigger to timer: (timer, count, Auto Reload)
@@ -153,62 +214,67 @@ void IRAM_ATTR ISRtimer()                                           // ISR funct
     */
 }
 
+void rmsCommand(const char *args)                                   // `rms`: print the latest RMS voltage & bands
+{
+    AudioLevel level;
+    audio.read(level);                                              // Consistent copy, no lock
+
+    Serial.print("RMS Voltage: ");
+    Serial.println(level.rms);                                      // print ADC RMS value
+    Serial.printf("Bands (V): Bass %.3f, Mid %.3f, Treble %.3f\n", level.bands[0], level.bands[1], level.bands[2]);
+    Serial.printf("Blocks: %u, LED Frames: %u\n", level.blocks, framesRendered);
+}
+
+void echoMessage(const char *line)                                  // Any other line is echoed back to the Terminal
+{
+    Message rxMsg;
+    Serial.print("User Entered: ");
+    snprintf(rxMsg.msgBody, MSG_LEN, "%s", line);                   // Truncate: CLI lines can be longer than `msgBody`
+    xQueueSend(msgQueue, (void *)&rxMsg, 10);                       // Send to msg_queue
+}
+
 void userCLI(void *param)
 {
     Message rxMsg;                                                  // struct for error messages
-    char input;
-    char commandBuf[CMD_BUF_LEN];                                   // create 255 char buffer
-    uint8_t index = 0;
-    uint8_t cmdLen = strlen(termCommand);                           // cmdLen for "rms" command = 3
 
-    memset(commandBuf, 0, CMD_BUF_LEN);                             // Clear the user CLI buffer
+    cli.add(termCommand, rmsCommand);                               // If User Enters "rms" into CLI
+    cli.setDefault(echoMessage);
+    cli.begin(Serial, Serial);                                      // Echo user entered characters to the Terminal
     
+    QueueHandle_t queue;
+    cli.poll();                                                     // Anything typed before `onReceive()` was hooked up
+
     for(;;)
     {
-        if(xQueueReceive(msgQueue, (void *)&rxMsg, 0) == pdTRUE)    // Check for any messages in Queue
+        WaitSet<1>::Event event = events.wait(queue);               // Sleep until there is something to do
+        if(event == events.EV_QUEUE && xQueueReceive(queue, (void *)&rxMsg, 0) == pdTRUE)
         {
             Serial.println(rxMsg.msgBody);                          // print any messages to Terminal
         }
-
-        if(Serial.available() > 0)
+        else if(event == events.EV_SERIAL)
+        {
+            cli.poll();                                             // Read, echo & dispatch everything received
+        }
+        else if(event == events.EV_SHUTDOWN)
         {
-            input = Serial.read();                                  // Read characters from terminal
-            
-            if(index < CMD_BUF_LEN - 1)                             // if buffer is not full (255 char)
-            {
-                commandBuf[index] = input;                          // Store characters in buffer
-                index++;
-            }
-
-            if(input == '\n')                                       // When user presses enter key
-            {
-                Serial.print("\n");                                 // print newline in Terminal
-                
-                commandBuf[index] = '\0';                           // NULL terminate buffer string
-                
-                //if(strcmp(commandBuf, termCommand) == 0)          // DIDNT WORK. REF: https://cplusplus.com/reference/cstring/strcmp/
-                if(memcmp(commandBuf, termCommand, cmdLen) == 0)    // If User Enters "rms" into CLI: If no characters differ (strings are equal)
-                {
-                    Serial.print("RMS Voltage: ");                  // REF: https://cplusplus.com/reference/cstring/memcmp/
-                    Serial.println(ADCrms);                         // print ADC average value
-                }
-                else                                                // Echo user message to the Terminal
-                {
-                    Serial.print("User Entered: ");
-                    strcpy(rxMsg.msgBody, commandBuf);              // Print user message to terminal
-                    xQueueSend(msgQueue, (void *)&rxMsg, 10);       // Send to msg_queue
-                }
-                memset(commandBuf, 0, CMD_BUF_LEN);                 // Clear the buffer
-                index = 0;                                          // Reset index
-            }
-            else
-            {
-                Serial.print(input);                                // Echo user entered characters to the Terminal
-            }
+            break;
         }
-        vTaskDelay(CLIdelay / portTICK_PERIOD_MS);                  // Yield to other tasks (25ms) to prevent starving
     }
+    vTaskDelete(NULL);
 }
+float bandAmplitude(float coeff, float offset)                      // Goertzel: 1 DFT bin in 1 pass, amplitude in ADC counts
+{
+    float s1 = 0.0;
+    float s2 = 0.0;
+    for(int i = 0; i < BUF_LEN; i++)
+    {
+        float s0 = ((float)readFrom[i] - offset) + coeff * s1 - s2;
+        s2 = s1;
+        s1 = s0;
+    }
+    return sqrtf(max(s1 * s1 + s2 * s2 - coeff * s1 * s2, 0.0f)) * 2.0 / BUF_LEN;
+}
+
 void calcRMS(void *param)                                           // Calculate RMS of 10 ADC values
 {
     Message errMsg;
@@ -217,11 +283,21 @@ void calcRMS(void *param)                                           // Calculate
     float localADCavg = 0.0;
     float localADCvoltage = 0.0;
     float LEDbrightness;
+    float coeffs[NUM_BANDS];
+    uint32_t blocks = 0;
     int i, j;
 
+    for(i = 0; i < NUM_BANDS; i++)
+    {
+        float bin = roundf(bandHz[i] * BUF_LEN / SampleHz);         // Nearest bin to the band center
+        coeffs[i] = 2.0 * cosf(2.0 * PI * bin / BUF_LEN);
+    }
+
     for(;;)
     {
         ulTaskNotifyTake(pdTRUE, portMAX_DELAY);                    // Wait for notification from ISR (similar to binary semaphore but FASTER)
+        localADCavg = 0.0;                                          // Every block starts from 0
+        localRMS = 0.0;
         
         for(i = 0; i < BUF_LEN; i++)
         {
@@ -233,7 +309,7 @@ void calcRMS(void *param)                                           // Calculate
 
         for(j = 0; j < BUF_LEN; j++)
         {
-            someVal = ((float)readFrom[i] * ADCvoltage) / (float)ADCmax;
+            someVal = ((float)readFrom[j] * ADCvoltage) / (float)ADCmax;
             localRMS += powf((someVal - localADCvoltage), 2);
         }
         localRMS = sqrtf(localRMS / BUF_LEN);                       // RMS value after calculations
@@ -241,9 +317,18 @@ void calcRMS(void *param)                                           // Calculate
         LEDbrightness = (localRMS * UINT16_MAX) / ADCvoltage;       // Update LED brightness
         ledcWrite(PWMch, LEDbrightness);
 
-        portENTER_CRITICAL(&spinlock);                              // Enter critical section: updating a shared float may take multiple instructions
-        ADCrms = localRMS;                                          // Update global variable
-        portEXIT_CRITICAL(&spinlock);                               // Exit critical section
+        float bands[NUM_BANDS];
+        for(i = 0; i < NUM_BANDS; i++)
+        {
+            bands[i] = bandAmplitude(coeffs[i], localADCavg) * ADCvoltage / (float)ADCmax;
+        }
+        blocks++;
+        audio.update([localRMS, &bands, blocks](AudioLevel &level)  // Copy only: the renderer is never held up
+        {
+            level.rms = localRMS;
+            memcpy(level.bands, bands, sizeof(level.bands));
+            level.blocks = blocks;
+        });
 
         if(bufOverrun == 1)
         {
@@ -256,4 +341,45 @@ void calcRMS(void *param)                                           // Calculate
         xSemaphoreGive(semDoneReading);
         portEXIT_CRITICAL(&spinlock);
     }
-}
\ No newline at end of file
+}
+
+void renderLEDs(void *param)                                        // Level & bands -> hue & brightness every frame
+{
+    AudioLevel level = {};
+    uint32_t seen = 0;
+    float bright = 0.0;                                             // Smoothed 0 - 1
+    float hue = 0.0;                                                // Smoothed 0 (bass, red) - 170 (treble, blue)
+    TickType_t lastWake = xTaskGetTickCount();
+    int64_t lastUs = esp_timer_get_time();
+
+    for(;;)
+    {
+        vTaskDelayUntil(&lastWake, FrameMs / portTICK_PERIOD_MS);   // Fixed frame rate, independent of the block rate
+        int64_t nowUs = esp_timer_get_time();
+        float dt = (nowUs - lastUs) / 1000000.0;
+        lastUs = nowUs;
+
+        if(audio.version() != seen)                                 // 1 word per frame until a new block lands
+        {
+            seen = audio.read(level);
+        }
+
+        float targetBright = min(level.rms / LevelFullScale, 1.0f);
+        float total = level.bands[0] + level.bands[1] + level.bands[2];
+        float targetHue = (total > 0.0) ? (level.bands[1] * 85.0 + level.bands[2] * 170.0) / total : hue;
+
+        float tau = (targetBright > bright) ? AttackSec : DecaySec;  // Exponential smoothing by elapsed time
+        bright += (targetBright - bright) * (1.0 - expf(-dt / tau));
+        hue += (targetHue - hue) * (1.0 - expf(-dt / HueSec));
+
+        LedTables::Rgb color = LedTables::wheel[(uint8_t)hue];
+        float lit = bright * NUM_LEDS;                              // 1 LED: brightness, strip: level meter
+        for(int i = 0; i < NUM_LEDS; i++)
+        {
+            uint16_t scale = (uint16_t)(constrain(lit - i, 0.0f, 1.0f) * 256.0);
+            leds[i] = CRGB((color.r * scale) >> 8, (color.g * scale) >> 8, (color.b * scale) >> 8);
+        }
+        FastLED.show();
+        framesRendered++;
+    }
+}
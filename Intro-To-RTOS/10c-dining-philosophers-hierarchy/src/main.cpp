@@ -6,9 +6,13 @@
  * analogous to 5 different users or functions that need to share the same resource
  * on a network. Since the shared resource can only be accessed by 1 user at a time,
  * we must prevent deadlock and/or starving.
+ * Messages are logged with `BLOG()` (lib/BinLog): only a format ID & the raw arguments
+ * are sent. Decode with `tools/binlog_dict.py` & `tools/binlog_decode.py`, or build with
+ * `-D BINLOG_TEXT=1` to print plain text.
 */
 
 #include <Arduino.h>
+#include "BinLog.h"                                                             // lib/BinLog: deferred binary logging
 //#include <semphr.h>                                                           // Only for Vanilla FreeRTOS
 
 #if CONFIG_FREERTOS_UNICORE
@@ -27,7 +31,6 @@ static SemaphoreHandle_t chopstick[NUM_TASKS];
 void eatTask(void *param)
 {
     int num;
-    char buffer[50];
     int index1, index2;
 
     num = *(int *)param;                                                        // Copy parameter & increment semaphore count.
@@ -45,54 +48,47 @@ void eatTask(void *param)
     }
 
     xSemaphoreTake(chopstick[index1], portMAX_DELAY);                           // Take Lower # chopstick 1st always
-    sprintf(buffer, "Eat 1: Philosopher %d Took Chopstick %d\n\n", num, num);
-    Serial.print(buffer);
+    BLOG("Eat 1: Philosopher %d Took Chopstick %d\n\n", num, num);
 
     vTaskDelay(1 / portTICK_PERIOD_MS);                                         // Delay forces deadlock
 
     xSemaphoreTake(chopstick[index2], portMAX_DELAY);                           // Take Higher # chopstick 2nd always
-    sprintf(buffer, "Eat 2: Philosopher %d Took Chopstick %d\n\n", num, (num + 1) % NUM_TASKS);
-    Serial.print(buffer);
+    BLOG("Eat 2: Philosopher %d Took Chopstick %d\n\n", num, (num + 1) % NUM_TASKS);
 
-    sprintf(buffer, "Eat 3: Philosopher %d is eating\n\n", num);                // "Shared Resource" = eating
-    Serial.print(buffer);
+    BLOG("Eat 3: Philosopher %d is eating\n\n", num);                           // "Shared Resource" = eating
     vTaskDelay(10 / portTICK_PERIOD_MS);
 
     xSemaphoreGive(chopstick[index2]);                                          // Put down higher # chopstick 1st always
-    sprintf(buffer, "Eat 4: Philosopher %d Returned Chopstick %d\n\n", num, (num + 1) % NUM_TASKS);
-    Serial.print(buffer);
+    BLOG("Eat 4: Philosopher %d Returned Chopstick %d\n\n", num, (num + 1) % NUM_TASKS);
 
     xSemaphoreGive(chopstick[index1]);                                          // Put down lower # chopstick 2nd always
-    sprintf(buffer, "Eat 5: Philosopher %d Returned Chopstick %d\n\n", num, num);
-    Serial.print(buffer);
+    BLOG("Eat 5: Philosopher %d Returned Chopstick %d\n\n", num, num);
 
     xSemaphoreGive(doneSemaphore);                                              // Notify Main Task & Delete Self
-    sprintf(buffer, "Eat 6: Done...Deleting Task #%d Now...\n\n", num);
-    Serial.print(buffer);
+    BLOG("Eat 6: Done...Deleting Task #%d Now...\n\n", num);
     vTaskDelete(NULL);
 }
 
 void setup()
 {
     char taskName[30];
-    char testBuffer[80];
     
     binSemaphore = xSemaphoreCreateBinary();
     doneSemaphore = xSemaphoreCreateCounting(NUM_TASKS, 0);
 
     Serial.begin(115200);
     vTaskDelay(1000 / portTICK_PERIOD_MS);
-    Serial.println("\n\n=>> FreeRTOS Dining Philosopher\'s Challenge: Hierarchy <<=\n");
+    BinLog::begin(Serial, app_cpu);                                             // Drain task streams `BLOG()` records to Serial
+    BLOG("\n\n=>> FreeRTOS Dining Philosopher\'s Challenge: Hierarchy <<=\n\n");
     
     int i, j, k;
     for(i = 0; i < NUM_TASKS; i++)
     {
         chopstick[i] = xSemaphoreCreateMutex();
-        sprintf(testBuffer, "Setup 1: Created & Gave Mutex (chopstick) #%d\n", i);
-        Serial.print(testBuffer);
+        BLOG("Setup 1: Created & Gave Mutex (chopstick) #%d\n", i);
     }
 
-    Serial.print("\n");
+    BLOG("\n");                                                                 // Through the ring too, or it passes the "Setup 1" records
     
     for(j = 0; j < NUM_TASKS; j++)                                              // Simulate 5 Philosophers Starting to eat
     {
@@ -107,18 +103,16 @@ void setup()
             app_cpu
         );
         xSemaphoreTake(binSemaphore, portMAX_DELAY);
-        sprintf(testBuffer, "Setup 2: Task #%d Created & Took binSemaphore %d\n\n", j, j);
-        Serial.print(testBuffer);
+        BLOG("Setup 2: Task #%d Created & Took binSemaphore %d\n\n", j, j);
     }
 
     for(k = 0; k < NUM_TASKS; k++)
     {
         xSemaphoreTake(doneSemaphore, portMAX_DELAY);                           // All 5 philosophers have eaten
-        sprintf(testBuffer, "Setup 3: Task #%d Finished & Took doneSemaphore #%d\n\n", k, k);
-        Serial.print(testBuffer);
+        BLOG("Setup 3: Task #%d Finished & Took doneSemaphore #%d\n\n", k, k);
     }
     
-    Serial.print("\nDONE! No Deadlock Occurred!\n");                            // Success Message
+    BLOG("\nDONE! No Deadlock Occurred!\n");                                    // Success Message
 }
 
 void loop() {}
\ No newline at end of file
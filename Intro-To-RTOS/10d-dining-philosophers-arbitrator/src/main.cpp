@@ -8,9 +8,13 @@
  * we must prevent deadlock and/or starving.
  * This is an alternate solution that uses an arbitrator to decide who can "eat" or
  * use the shared resource, since only one can access it at any time.
+ * Messages are logged with `BLOG()` (lib/BinLog): only a format ID & the raw arguments
+ * are sent. Decode with `tools/binlog_dict.py` & `tools/binlog_decode.py`, or build with
+ * `-D BINLOG_TEXT=1` to print plain text.
 */
 
 #include <Arduino.h>
+#include "BinLog.h"                                                             // lib/BinLog: deferred binary logging
 //#include <semphr.h>                                                           // Only for Vanilla FreeRTOS
 
 #if CONFIG_FREERTOS_UNICORE
@@ -30,51 +34,41 @@ static SemaphoreHandle_t arbitrator;
 void eatTask(void *param)
 {
     int num;
-    char buffer[80];
 
     num = *(int *)param;                                                        // Copy parameter & increment semaphore count.
     xSemaphoreGive(binSemaphore);
 
     xSemaphoreTake(arbitrator, portMAX_DELAY);                                  // Get Permission from arbitrator. Each person waits their turn to eat.
-    sprintf(buffer, "Eat 1: Philosopher %d Got Permission From Arbitrator\n\n", num);
-    Serial.print(buffer);
+    BLOG("Eat 1: Philosopher %d Got Permission From Arbitrator\n\n", num);
 
     xSemaphoreTake(chopstick[num], portMAX_DELAY);                              // Take Lower # chopstick 1st always
-    sprintf(buffer, "Eat 2: Philosopher %d Took Chopstick %d\n\n", num, num);
-    Serial.print(buffer);
+    BLOG("Eat 2: Philosopher %d Took Chopstick %d\n\n", num, num);
 
     vTaskDelay(1 / portTICK_PERIOD_MS);                                         // Delay forces deadlock
 
     xSemaphoreTake(chopstick[(num + 1) % NUM_TASKS], portMAX_DELAY);            // Take Higher # chopstick 2nd always
-    sprintf(buffer, "Eat 3: Philosopher %d Took Chopstick %d\n\n", num, (num + 1) % NUM_TASKS);
-    Serial.print(buffer);
+    BLOG("Eat 3: Philosopher %d Took Chopstick %d\n\n", num, (num + 1) % NUM_TASKS);
 
-    sprintf(buffer, "Eat 4: Philosopher %d is eating\n\n", num);                // "Shared Resource" = eating
-    Serial.print(buffer);
+    BLOG("Eat 4: Philosopher %d is eating\n\n", num);                           // "Shared Resource" = eating
     vTaskDelay(10 / portTICK_PERIOD_MS);
 
     xSemaphoreGive(chopstick[(num + 1) % NUM_TASKS]);                           // Put down higher # chopstick 1st always
-    sprintf(buffer, "Eat 5: Philosopher %d Returned Chopstick %d\n\n", num, (num + 1) % NUM_TASKS);
-    Serial.print(buffer);
+    BLOG("Eat 5: Philosopher %d Returned Chopstick %d\n\n", num, (num + 1) % NUM_TASKS);
 
     xSemaphoreGive(chopstick[num]);                                             // Put down lower # chopstick 2nd always
-    sprintf(buffer, "Eat 6: Philosopher %d Returned Chopstick %d\n\n", num, num);
-    Serial.print(buffer);
+    BLOG("Eat 6: Philosopher %d Returned Chopstick %d\n\n", num, num);
 
-    sprintf(buffer, "Eat 7: Philosopher %d Notified Arbitrator They Are Finished\n\n", num);
-    Serial.print(buffer);
+    BLOG("Eat 7: Philosopher %d Notified Arbitrator They Are Finished\n\n", num);
     xSemaphoreGive(arbitrator);                                                 // Done Eating: Notify Arbitrator
 
     xSemaphoreGive(doneSemaphore);                                              // Notify Main Task & Delete Self
-    sprintf(buffer, "Eat 8: Done...Deleting Task #%d Now...\n\n", num);
-    Serial.print(buffer);
+    BLOG("Eat 8: Done...Deleting Task #%d Now...\n\n", num);
     vTaskDelete(NULL);
 }
 
 void setup()
 {
     char taskName[30];
-    char testBuffer[80];
     
     binSemaphore = xSemaphoreCreateBinary();
     doneSemaphore = xSemaphoreCreateCounting(NUM_TASKS, 0);
@@ -82,17 +76,17 @@ void setup()
 
     Serial.begin(115200);
     vTaskDelay(1000 / portTICK_PERIOD_MS);
-    Serial.println("\n\n=>> FreeRTOS Dining Philosopher\'s Challenge: Hierarchy <<=\n");
+    BinLog::begin(Serial, app_cpu);                                             // Drain task streams `BLOG()` records to Serial
+    BLOG("\n\n=>> FreeRTOS Dining Philosopher\'s Challenge: Hierarchy <<=\n\n");
     
     int i, j, k;
     for(i = 0; i < NUM_TASKS; i++)
     {
         chopstick[i] = xSemaphoreCreateMutex();
-        sprintf(testBuffer, "Setup 1: Created & Gave Mutex (chopstick) #%d\n", i);
-        Serial.print(testBuffer);
+        BLOG("Setup 1: Created & Gave Mutex (chopstick) #%d\n", i);
     }
 
-    Serial.print("\n");
+    BLOG("\n");                                                                 // Through the ring too, or it passes the "Setup 1" records
     
     for(j = 0; j < NUM_TASKS; j++)                                              // Simulate 5 Philosophers Starting to eat
     {
@@ -107,18 +101,16 @@ void setup()
             app_cpu
         );
         xSemaphoreTake(binSemaphore, portMAX_DELAY);
-        sprintf(testBuffer, "Setup 2: Task #%d Created & Took binSemaphore %d\n\n", j, j);
-        Serial.print(testBuffer);
+        BLOG("Setup 2: Task #%d Created & Took binSemaphore %d\n\n", j, j);
     }
 
     for(k = 0; k < NUM_TASKS; k++)
     {
         xSemaphoreTake(doneSemaphore, portMAX_DELAY);                           // All 5 philosophers have eaten
-        sprintf(testBuffer, "Setup 3: Task #%d Finished & Took doneSemaphore #%d\n\n", k, k);
-        Serial.print(testBuffer);
+        BLOG("Setup 3: Task #%d Finished & Took doneSemaphore #%d\n\n", k, k);
     }
     
-    Serial.print("\nDONE! No Deadlock Occurred!\n");                            // Success Message
+    BLOG("\nDONE! No Deadlock Occurred!\n");                                    // Success Message
 }
 
 void loop() {}
\ No newline at end of file
@@ -7,6 +7,8 @@
 */
 
 #include <Arduino.h>
+#include "SerialCLI.h"                                                          // lib/SerialCLI: line assembly, echo & dispatch
+#include "WaitSet.h"                                                            // lib/WaitSet: block on serial RX & msgQueue together
 //#include <semphr.h>                                                           // Only for Vanilla FreeRTOS
 
 static const BaseType_t PRO_CPU = 0;
@@ -20,7 +22,6 @@ enum { CMD_BUF_LEN = 255 };
 static const char avgCmd[] = "avg";
 static const uint16_t timerDivider = 8;                                         // 80MHz / 8 = 10MHz
 static const uint64_t timerMaxCount = 1000000;                                  // Timer counts to this value
-static const uint32_t CLIdelay = 25;
 static const int ADCpin = A0;                                                   // ADC = GPIO_26 = A0;
 
 static portMUX_TYPE spinlock = portMUX_INITIALIZER_UNLOCKED;
@@ -28,6 +29,8 @@ static hw_timer_t *timer = NULL;
 static TaskHandle_t processTask = NULL;
 static SemaphoreHandle_t semDoneReading = NULL;
 static QueueHandle_t msgQueue;
+static SerialCLI<CMD_BUF_LEN, 1> cli;                                           // 1 command: `avg`
+static WaitSet<1> events;                                                       // Wakes the CLI task: msgQueue or serial RX
 
 static volatile uint16_t buf0[BUF_LEN];
 static volatile uint16_t buf1[BUF_LEN];
@@ -79,60 +82,48 @@ void IRAM_ATTR ISRtimer()
     //portYIELD_FROM_ISR(taskWoken);                                            // Vanilla FreeRTOS
 }
 
+void avgCommand(const char *args)                                               // `avg`: print the latest average
+{
+    Serial.print("Average ADC Value: ");
+    Serial.println(ADCavg);                                                     // print ADC average value
+}
+
+void echoMessage(const char *line)                                              // Any other line is echoed back to the Terminal
+{
+    Message rxMsg;
+    Serial.print("User Entered: ");
+    snprintf(rxMsg.msgBody, MSG_LEN, "%s", line);                               // Truncate: CLI lines can be longer than `msgBody`
+    xQueueSend(msgQueue, (void *)&rxMsg, 10);                                   // Send to msgQueue
+}
+
 void CLItask(void *param)
 {
     Message rxMsg;
-    char input;
-    char cmdBuffer[CMD_BUF_LEN];
-    uint8_t index = 0;
-    uint8_t cmdLength = strlen(avgCmd);
 
-    memset(cmdBuffer, 0, CMD_BUF_LEN);                                          // Clear the buffer
+    cli.add(avgCmd, avgCommand);                                                // If User Enters "avg" into CLI
+    cli.setDefault(echoMessage);
+    cli.begin(Serial, Serial);                                                  // Echo user entered characters to the Terminal
+
+    QueueHandle_t queue;
+    cli.poll();                                                                 // Anything typed before `onReceive()` was hooked up
 
     for(;;)
     {
-        if(xQueueReceive(msgQueue, (void *)&rxMsg, 0) == pdTRUE)
+        WaitSet<1>::Event event = events.wait(queue);                           // Sleep until there is something to do
+        if(event == events.EV_QUEUE && xQueueReceive(queue, (void *)&rxMsg, 0) == pdTRUE)
         {
             Serial.println(rxMsg.msgBody);                                      // Print received messages
         }
-        
-        if(Serial.available() > 0)
+        else if(event == events.EV_SERIAL)
+        {
+            cli.poll();                                                         // Read, echo & dispatch everything received
+        }
+        else if(event == events.EV_SHUTDOWN)
         {
-            input = Serial.read();                                              // Read characters from terminal
-            
-            if(index < CMD_BUF_LEN - 1)                                         // if buffer is not full (255 char)
-            {
-                cmdBuffer[index++] = input;                                     // Store characters in buffer
-            }
-
-            if(input == '\n')                                                   // When user presses enter key
-            {
-                Serial.print("\n");                                             // print newline in Terminal
-                
-                cmdBuffer[index - 1] = '\0';                                    // NULL terminate buffer string
-                
-                //if(strcmp(cmdBuffer, avgCommand) == 0)                        // DIDNT WORK. REF: https://cplusplus.com/reference/cstring/strcmp/
-                if(memcmp(cmdBuffer, avgCmd, cmdLength) == 0)                   // If User Enters "avg" into CLI: If no characters differ (strings are equal)
-                {
-                    Serial.print("Average ADC Value: ");                        // REF: https://cplusplus.com/reference/cstring/memcmp/
-                    Serial.println(ADCavg);                                     // print ADC average value
-                }
-                else                                                            // Echo user message to the Terminal
-                {
-                    Serial.print("User Entered: ");
-                    strcpy(rxMsg.msgBody, cmdBuffer);                           // Print user message to terminal
-                    xQueueSend(msgQueue, (void *)&rxMsg, 10);                   // Send to msgQueue
-                }
-                memset(cmdBuffer, 0, CMD_BUF_LEN);                              // Clear the buffer
-                index = 0;                                                      // Reset index
-            }
-            else // if(input != '\n')
-            {
-                Serial.print(input);                                            // Echo user entered characters to the Terminal
-            }
+            break;
         }
-        vTaskDelay(CLIdelay / portTICK_PERIOD_MS);                              // Yield to other tasks for a short while
     }
+    vTaskDelete(NULL);
 }
 
 void calcAvg(void *param)
@@ -187,6 +178,14 @@ void setup()
     vTaskDelay(1000 / portTICK_PERIOD_MS);
     Serial.print("\n\n=>> FreeRTOS Multicore ADC Sample & Average w/ CLI <<=\n\n");
 
+    events.addQueue(msgQueue, MSG_QUEUE_LEN);                                   // Queues must be empty when they join the set
+    events.addSerial(Serial);                                                   // Serial RX wakes the CLI task instead of polling
+    if(!events.begin())
+    {
+        Serial.print("\n\nERROR: Could not instantiate queue set\n\n");
+        ESP.restart();
+    }
+
     xTaskCreatePinnedToCore(                                                    // CLI Terminal Runs on Core 1
         CLItask,
         "CLI Terminal",
@@ -4,8 +4,16 @@
  * ESP32 LEDC function Software Fade using 'ledcWrite' function
  * This example fades the on-board LED (pin 13) using a single task.
  * The Serial Terminal accepts integer values to change the speed of the fading effect
+ * The fade moves by elapsed time (`esp_timer_get_time()`), not by loop count, so its speed
+ * stays the same when frames run late or the CPU clock changes.
+ * By default the LEDC peripheral does the fading (`lib/LedcFade`): the task only wakes at the
+ * top & bottom of each breath to reverse it. Build with `-D LEDC_HW_FADE=0` for the software
+ * fade, which also takes over if the hardware fade can't start.
  */
 #include <Arduino.h>
+#include "SerialCLI.h"                                             // lib/SerialCLI: line assembly, echo & dispatch
+#include "LedTables.h"                                              // lib/LedTables: 12-bit gamma curve in flash
+#include "LedcFade.h"                                               // lib/LedcFade: LEDC hardware ramps
 
 #if CONFIG_FREERTOS_UNICORE
     static const BaseType_t app_cpu = 0;
@@ -18,64 +26,68 @@ static const int LEDCtimer = 12;                                    // 12-bit pr
 static const int LEDCfreq = 5000;                                   // 5000 Hz LEDC base freq.
 static const int LEDpin = LED_BUILTIN;                              // Use pin 13 on-board LED for SW fading
 static const uint8_t bufLen = 20;                                   // Buffer Length setting for user CLI terminal
+static SerialCLI<bufLen, 0> cli;                                    // Default handler only
 
-static int brightness = 0;                                          // LED brightness
-static int fadeInterval = 5;                                        // LED fade interval
-static int delayInterval = 30;                                      // Delay between changing fade intervals
+static const int fadeInterval = 5;                                  // LED fade interval: brightness change every `delayInterval`
+static const uint32_t frameMs = 10;                                 // Fixed frame clock: 100 LED updates / second
+static int delayInterval = 30;                                      // Time (ms) to move 1 `fadeInterval`: sets the speed
 
 void ledcAnalogWrite(uint8_t channel, uint32_t value, uint32_t valueMax = 255)// 'value' must be between 0 & 'valueMax'
 {
-    uint32_t duty = (4095 / valueMax) * min(value, valueMax);       // calculate duty cycle: 2^12 - 1 = 4095
-    ledcWrite(channel, duty);                                       // write duty cycle to LEDC
+    uint32_t level = min(value, valueMax) * 255 / valueMax;         // 0 - 255
+    ledcWrite(channel, LedTables::gamma12[level]);                  // Perceptually even steps, 255 = 4095 (full on)
 }
 
 void LEDfadeTask(void *param)
 {
-    for(;;)
-    {
-        ledcAnalogWrite(LEDCchan, brightness);                      // Set brightness on LEDC channel 0
-        brightness += fadeInterval;                                 // Adjust brightness by fadeInterval
+    LedcFade fader;
+    bool rising = true;
 
-        if (brightness <= 0 || brightness >= 255)                   // Reverse fade effect at min/max values
+    fader.begin(LEDCchan);                                          // Fade-end interrupt notifies this task
+    while(fader.available())                                        // Hardware: 2 wakeups per breath
+    {
+        uint32_t rampMs = 255UL * max(delayInterval, 1) / fadeInterval; // Same speed as the software fade
+        if(!fader.fadeTo(rising ? LedTables::DUTY_MAX : 0, rampMs))
         {
-            fadeInterval = -fadeInterval;
+            break;                                                  // Fall back to software
         }
-        
-        vTaskDelay(delayInterval / portTICK_PERIOD_MS);             // CLI adjustable delay (non blocking)
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);                    // Sleep until the ramp ends
+        rising = !rising;
+    }
+
+    float phase = 0;                                                // 0 - 510: fading up below 255, down above
+    int64_t lastUs = esp_timer_get_time();                          // Monotonic us clock
+    TickType_t lastWake = xTaskGetTickCount();
+
+    for(;;)
+    {
+        int64_t nowUs = esp_timer_get_time();
+        float rate = (fadeInterval * 1000.0f) / max(delayInterval, 1); // Brightness units per second
+        phase = fmodf(phase + rate * ((nowUs - lastUs) / 1000000.0f), 510.0f);
+        lastUs = nowUs;
+
+        ledcAnalogWrite(LEDCchan, (phase <= 255.0f) ? phase : (510.0f - phase)); // Set brightness on LEDC channel 0
+        vTaskDelayUntil(&lastWake, frameMs / portTICK_PERIOD_MS);   // Fixed frame rate (non blocking)
     }
 }
 
+void setDelay(const char *line)                                     // Every line entered is a new delay value
+{
+    delayInterval = atoi(line);                                     // parse integers from CLI
+    Serial.print("New LED Delay = ");
+    Serial.print(delayInterval);
+    Serial.println("ms");
+}
+
 void readSerial(void *param)                                        // Function Definition for Task 2
 {
-    char input;                                                     // Each Character Input
-    char buf[bufLen];                                               // Array to hold user input characters
-    uint8_t index = 0;                                              // Number of characters entered by user.
-    memset(buf, 0, bufLen);                                         // Clear the buffer 1st
+    cli.setDefault(setDelay);                                       // No named commands: any line is a number
+    cli.begin(Serial, Serial);                                      // Echo user input to the terminal
 
     for(;;)
     {
-        if(Serial.available() > 0)                                  // Check If Serial Terminal is open.
-        {
-            input = Serial.read();                                  // Read user input from serial terminal
-            if(input == '\n')                                       // Update delay only if Enter key is pressed.
-            {
-                delayInterval = atoi(buf);                          // parse integers from CLI
-                Serial.print("\nNew LED Delay = ");
-                Serial.print(delayInterval);
-                Serial.println("ms");
-                memset(buf, 0, bufLen);                             // Clear buffer after user input read.
-                index = 0;                                          // Reset index
-            }
-            else
-            {
-                if(index < bufLen - 1)                              // Only append if index < message limit.
-                {
-                    buf[index] = input;
-                    index++;
-                    Serial.print(input);                            // Echo user input to the terminal
-                }
-            }
-        }
+        cli.poll();                                                 // Update delay only if Enter key is pressed.
+        vTaskDelay(20 / portTICK_PERIOD_MS);                        // Yield: the fade task shares this core
     }
 }
 
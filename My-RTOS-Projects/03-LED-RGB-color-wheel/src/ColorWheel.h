@@ -0,0 +1,39 @@
+/**
+ * Joel Brigida
+ * October 18, 2026
+ * The render step of `RGBcolorWheelTask`: fade the LED up & down & move to the next of 8
+ * colors at the bottom of every fade. Only math & a table lookup: no FastLED output or
+ * FreeRTOS calls, so `tools/led_render_bench.cpp` runs it on a PC too.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <FastLED.h>
+#include "LedTables.h"                                              // lib/LedTables: hue wheel in flash
+
+struct ColorWheel
+{
+    float phase;                                                    // 0 - 510: fading up below 255, down above
+    uint8_t hue;                                                    // add 32 each time: wraps after 8 colors
+    CRGB color;
+
+    explicit ColorWheel(int startBrightness)
+        : phase(startBrightness), hue(0), color(CRGB::Red) {}
+
+    uint8_t render(uint32_t dtUs, int fadeInterval, int delayMs)    // Advance by `dtUs`: returns the brightness
+    {
+        float rate = (fadeInterval * 1000.0f) / max(delayMs, 1);    // Brightness units per second
+        phase += rate * (dtUs / 1000000.0f);
+
+        if(phase >= 510.0f)                                         // Only change color at the bottom of the fade
+        {
+            uint32_t bottoms = phase / 510.0f;                      // Can be > 1 after a long stall
+            phase -= bottoms * 510.0f;
+            hue += 32 * bottoms;                                    // Change color
+            LedTables::Rgb next = LedTables::wheel[hue];            // Table lookup, no HSV conversion
+            color = CRGB(next.r, next.g, next.b);                   // Rotate: Rd-Orng-Yel-Grn-Aqua-Blu-Purp-Pnk
+        }
+        return (phase <= 255.0f) ? phase : (510.0f - phase);
+    }
+};
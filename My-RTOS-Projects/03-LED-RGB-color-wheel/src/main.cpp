@@ -4,10 +4,15 @@
  * ESP32 LEDC function Software Fade using 'ledcWrite' function
  * This example fades the on-board RGB LED (GPIO_2) using a single task.
  * The Serial Terminal accepts integer values to change the speed of the fading effect
+ * The fade moves by elapsed time (`esp_timer_get_time()`), not by loop count, so its speed
+ * stays the same when frames run late or the CPU clock changes.
+ * The render step itself is `ColorWheel.h`: the task only times frames & calls `FastLED.show()`.
  */
 
 #include <Arduino.h>
+#include "SerialCLI.h"                                             // lib/SerialCLI: line assembly, echo & dispatch
 #include <FastLED.h>
+#include "ColorWheel.h"                                             // Render step: no output, runs on a PC too
 
 #if CONFIG_FREERTOS_UNICORE
     static const BaseType_t app_cpu = 0;
@@ -21,76 +26,54 @@
 #define NUM_LEDS 1                                                  // Only 1 RGB LED on the ESP32 Thing Plus
 
 static const uint8_t bufLen = 20;                                   // Buffer Length setting for user CLI terminal
+static SerialCLI<bufLen, 0> cli;                                    // Default handler only
 
 static int brightness = 65;                                         // Initial Brightness value
-static int fadeInterval = 5;                                        // LED fade interval
-static int delayInterval = 30;                                      // Delay between changing fade intervals
+static const int fadeInterval = 5;                                  // LED fade interval: brightness change every `delayInterval`
+static const uint32_t frameMs = 10;                                 // Fixed frame clock: 100 LED updates / second
+static int delayInterval = 30;                                      // Time (ms) to move 1 `fadeInterval`: sets the speed
 
 CRGB leds[NUM_LEDS];                                                // Array for RGB LED on GPIO_2
 
 void RGBcolorWheelTask(void *param)
 {
-    leds[0] = CRGB::Red;
+    ColorWheel wheel(brightness);
+    leds[0] = wheel.color;
     FastLED.show();
-    int hueVal = 0;                                                 // add 32 each time...
+    int64_t lastUs = esp_timer_get_time();                          // Monotonic us clock
+    TickType_t lastWake = xTaskGetTickCount();
 
     for(;;)
     {
-        brightness += fadeInterval;                                 // Adjust brightness by fadeInterval
+        int64_t nowUs = esp_timer_get_time();
+        brightness = wheel.render((uint32_t)(nowUs - lastUs), fadeInterval, delayInterval);
+        lastUs = nowUs;
+
+        leds[0] = wheel.color;
         FastLED.setBrightness(brightness);
         FastLED.show();
-
-        if (brightness <= 0 || brightness >= 255)
-        {
-            fadeInterval = -fadeInterval;                           // Reverse fade effect
-            
-            if(brightness <= 0)                                     // Only change color if value <= 0
-            {
-                hueVal += 32;                                       // Change color
-                if(hueVal >= 255)
-                {
-                    hueVal = 0;                         
-                }
-                leds[0] = CHSV(hueVal, 255, 255);                   // Rotate: Rd-Orng-Yel-Grn-Aqua-Blu-Purp-Pnk
-                FastLED.show();
-            }
-        } 
-        vTaskDelay(delayInterval / portTICK_PERIOD_MS);             // CLI adjustable delay (non blocking)
+        vTaskDelayUntil(&lastWake, frameMs / portTICK_PERIOD_MS);   // Fixed frame rate (non blocking)
     }
 }
 
+void setDelay(const char *line)                                     // Every line entered is a new delay value
+{
+    delayInterval = atoi(line);                                     // parse integers from CLI
+    delayInterval = abs(delayInterval);                             // BUGFIX: value can't be negative
+    Serial.print("New LED Delay = ");
+    Serial.print(delayInterval);
+    Serial.println("ms");
+}
+
 void readSerial(void *param)                                        // Function Definition for Task 2
 {
-    char input;                                                     // Each Character Input
-    char buf[bufLen];                                               // Array to hold user input characters
-    uint8_t index = 0;                                              // Number of characters entered by user.
-    memset(buf, 0, bufLen);                                         // Clear the buffer 1st
+    cli.setDefault(setDelay);                                       // No named commands: any line is a number
+    cli.begin(Serial, Serial);                                      // Echo user input to the terminal
 
     for(;;)
     {
-        if(Serial.available() > 0)                                  // Check If Serial Terminal is open.
-        {
-            input = Serial.read();                                  // Read user input from serial terminal
-            if(input == '\n')                                       // Update delay only if Enter key is pressed.
-            {
-                delayInterval = atoi(buf);                          // parse integers from CLI
-                delayInterval = abs(delayInterval);                 // BUGFIX: value can't be negative
-                Serial.print("\nNew LED Delay = ");
-                Serial.print(delayInterval);
-                Serial.println("ms");
-                memset(buf, 0, bufLen);                             // Clear buffer after user input read.
-                index = 0;                                          // Reset index
-            }
-            else
-            {
-                if(index < bufLen - 1)                              // Only append if index < message limit.
-                {
-                    buf[index] = input;
-                    index++;
-                    Serial.print(input);                            // Echo user input to the terminal
-                }
-            }
-        }
+        cli.poll();                                                 // Update delay only if Enter key is pressed.
+        vTaskDelay(20 / portTICK_PERIOD_MS);                        // Yield: the fade task shares this core
     }
 }
 
@@ -0,0 +1,241 @@
+/**
+ * Joel Brigida
+ * October 18, 2026
+ * Pre-rendered LED animations streamed from SD by `play <file>`, authored offline with
+ * `tools/led_anim.py`. File format (little-endian):
+ *     Header, 16 bytes: "LEDA", version (1), encoding (0 = raw, 1 = RLE), fps (uint16),
+ *                       LED count (uint16), reserved (uint16), frame count (uint32, 0 = to EOF)
+ *     Raw frame:        LED count x [r, g, b]
+ *     RLE frame:        byte count (uint16), then runs of [count 1 - 255, r, g, b]
+ * `playTask` reads & decodes ahead into 1 half of `AnimationStream` while the LED task copies
+ * the other half out at the file's frame rate (`AnimationPlayer`, pattern 6). When the next
+ * frame isn't decoded in time, the LEDs keep the last frame & an underrun is counted.
+ * Files with fewer LEDs than the strip leave the rest dark, extra LEDs are dropped.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <FastLED.h>
+#include <atomic>
+
+enum AnimEncoding : uint8_t
+{
+    ANIM_RAW = 0,
+    ANIM_RLE = 1
+};
+
+struct AnimationHeader
+{
+    enum { SIZE = 16 };
+    enum { MAX_LEDS = 2048 };                                                   // Bounds the staging buffer
+    enum { MAX_FPS = 100 };                                                     // The LED task's frame clock
+
+    uint8_t encoding;
+    uint16_t fps;
+    uint16_t leds;
+    uint32_t frames;                                                            // 0 = play to the end of the file
+
+    bool parse(const uint8_t *raw)                                              // false: not an animation we can play
+    {
+        encoding = raw[5];
+        fps = raw[6] | (raw[7] << 8);
+        leds = raw[8] | (raw[9] << 8);
+        frames = raw[12] | (raw[13] << 8) | ((uint32_t)raw[14] << 16) | ((uint32_t)raw[15] << 24);
+        return memcmp(raw, "LEDA", 4) == 0 && raw[4] == 1 && encoding <= ANIM_RLE &&
+               fps >= 1 && fps <= MAX_FPS && leds >= 1 && leds <= MAX_LEDS;
+    }
+
+    size_t maxFrameBytes() const                                                // RLE worst case: every run is 1 LED
+    {
+        return (size_t)leds * ((encoding == ANIM_RLE) ? 4 : 3);
+    }
+};
+
+inline void decodeRaw(const uint8_t *src, size_t fileLeds, CRGB *dest, size_t numLeds)
+{
+    size_t count = min(fileLeds, numLeds);
+    memcpy(dest, src, count * sizeof(CRGB));                                    // CRGB is 3 packed bytes: r, g, b
+    if(count < numLeds)
+    {
+        fill_solid(dest + count, numLeds - count, CRGB::Black);
+    }
+}
+
+inline bool decodeRle(const uint8_t *src, size_t len, CRGB *dest, size_t numLeds) // false: runs don't fit 4-byte steps
+{
+    size_t led = 0;
+    for(size_t i = 0; i + 4 <= len; i += 4)
+    {
+        CRGB color(src[i + 1], src[i + 2], src[i + 3]);
+        for(uint8_t n = 0; n < src[i] && led < numLeds; n++)                    // LEDs past the strip are dropped
+        {
+            dest[led++] = color;
+        }
+    }
+    if(led < numLeds)
+    {
+        fill_solid(dest + led, numLeds - led, CRGB::Black);
+    }
+    return (len % 4) == 0;
+}
+
+class AnimationStream                                                           // SD reader task -> LED task, 2 decoded frames
+{
+public:
+    AnimationStream(CRGB *buffer0, CRGB *buffer1, size_t numLeds)
+        : count(numLeds)
+    {
+        buffers[0] = buffer0;
+        buffers[1] = buffer1;
+    }
+
+    /*** Reader Side ***/
+
+    void start(uint16_t framesPerSecond)                                        // From the task that will call `fill()`
+    {
+        reader = xTaskGetCurrentTaskHandle();
+        rate = framesPerSecond;
+        written.store(0, std::memory_order_relaxed);
+        consumed.store(0, std::memory_order_relaxed);
+        shownFrames = 0;
+        underrunFrames = 0;
+        bytesRead = 0;
+        readUs = 0;
+        startUs = esp_timer_get_time();
+        firstTakeUs = startUs;
+        lastTakeUs = startUs;
+        session++;
+        active = true;                                                          // Last: the LED task may look any time now
+    }
+
+    CRGB *fill(TickType_t wait)                                                 // Free half to decode into, NULL = both still unread
+    {
+        if(written.load(std::memory_order_relaxed) - consumed.load(std::memory_order_acquire) >= 2)
+        {
+            ulTaskNotifyTake(pdTRUE, wait);                                     // `take()` wakes us
+            if(written.load(std::memory_order_relaxed) - consumed.load(std::memory_order_acquire) >= 2)
+            {
+                return NULL;
+            }
+        }
+        return buffers[written.load(std::memory_order_relaxed) % 2];
+    }
+
+    void filled(uint32_t bytes, uint32_t us)                                    // Hand the `fill()` half to the LED task
+    {
+        bytesRead += bytes;
+        readUs += us;
+        written.fetch_add(1, std::memory_order_release);
+    }
+
+    bool drain(TickType_t wait)                                                 // After the last frame: true once all were shown
+    {
+        while(written.load(std::memory_order_relaxed) != consumed.load(std::memory_order_acquire))
+        {
+            if(ulTaskNotifyTake(pdTRUE, wait) == 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void finish()
+    {
+        active = false;
+    }
+
+    /*** LED Task Side ***/
+
+    bool ready() const                                                          // A decoded frame is waiting
+    {
+        return consumed.load(std::memory_order_relaxed) != written.load(std::memory_order_acquire);
+    }
+
+    void missed()                                                               // A frame was due & nothing was `ready()`
+    {
+        underrunFrames++;
+    }
+
+    void take(CRGB *dest)                                                       // Only after `ready()`: copy out the next frame
+    {
+        uint32_t next = consumed.load(std::memory_order_relaxed);
+        memcpy(dest, buffers[next % 2], count * sizeof(CRGB));
+        consumed.store(next + 1, std::memory_order_release);
+        shownFrames++;
+        lastTakeUs = esp_timer_get_time();
+        if(next == 0)
+        {
+            firstTakeUs = lastTakeUs;
+        }
+        xTaskNotifyGive(reader);                                                // That half is free again
+    }
+
+    bool playing() const
+    {
+        return active;
+    }
+
+    uint16_t fps() const
+    {
+        return rate;
+    }
+
+    uint32_t id() const                                                         // Changes with every `start()`
+    {
+        return session;
+    }
+
+    /*** Stats ***/
+
+    uint32_t shown() const
+    {
+        return shownFrames;
+    }
+
+    uint32_t underruns() const                                                  // Frame times with nothing decoded yet
+    {
+        return underrunFrames;
+    }
+
+    uint32_t fpsX10() const                                                     // Sustained: frame intervals / 1st to last frame
+    {
+        int64_t us = lastTakeUs - firstTakeUs;
+        return (shownFrames > 1 && us > 0) ? (uint32_t)((uint64_t)(shownFrames - 1) * 10000000ULL / us) : 0;
+    }
+
+    uint32_t readKBps() const                                                   // SD bandwidth while actually reading
+    {
+        return (readUs > 0) ? (uint32_t)(bytesRead * 1000000ULL / 1024 / readUs) : 0;
+    }
+
+    uint32_t busyPercent() const                                                // Share of the play time spent reading
+    {
+        int64_t us = lastTakeUs - startUs;
+        return (us > 0) ? (uint32_t)(readUs * 100 / us) : 0;
+    }
+
+    uint64_t bytes() const
+    {
+        return bytesRead;
+    }
+
+private:
+    CRGB *buffers[2];
+    size_t count;
+    std::atomic<uint32_t> written{0};                                           // Frames decoded: only the reader writes it
+    std::atomic<uint32_t> consumed{0};                                          // Frames taken: only the LED task writes it
+    TaskHandle_t reader = NULL;
+    volatile bool active = false;
+    volatile uint16_t rate = 30;
+    volatile uint32_t session = 0;
+
+    volatile uint32_t shownFrames = 0;
+    volatile uint32_t underrunFrames = 0;
+    uint64_t bytesRead = 0;
+    uint64_t readUs = 0;
+    int64_t startUs = 0;
+    volatile int64_t firstTakeUs = 0;
+    volatile int64_t lastTakeUs = 0;
+};
@@ -0,0 +1,162 @@
+/**
+ * Joel Brigida
+ * October 18, 2026
+ * COBS framing & CRC16 for the binary CLI protocol. See `BinProtocol.h`.
+ * COBS Ref: https://en.wikipedia.org/wiki/Consistent_Overhead_Byte_Stuffing
+ */
+
+#include "BinProtocol.h"
+#include <string.h>
+
+namespace BinProtocol
+{
+    uint16_t crc16(const uint8_t *data, size_t len)                            // CRC-16/CCITT-FALSE, bitwise (frames are short)
+    {
+        uint16_t crc = 0xFFFF;
+        for(size_t i = 0; i < len; i++)
+        {
+            crc ^= (uint16_t)data[i] << 8;
+            for(int bit = 0; bit < 8; bit++)
+            {
+                crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+            }
+        }
+        return crc;
+    }
+
+    size_t cobsEncode(const uint8_t *src, size_t len, uint8_t *dst)
+    {
+        size_t codeIndex = 0;                                                   // Where the current block's code byte goes
+        size_t out = 1;
+        uint8_t code = 1;
+
+        for(size_t i = 0; i < len; i++)
+        {
+            if(src[i] == 0)
+            {
+                dst[codeIndex] = code;                                          // Close the block at every zero
+                codeIndex = out++;
+                code = 1;
+            }
+            else
+            {
+                dst[out++] = src[i];
+                code++;
+                if(code == 0xFF)                                                // Max block length: start a new one
+                {
+                    dst[codeIndex] = code;
+                    codeIndex = out++;
+                    code = 1;
+                }
+            }
+        }
+        dst[codeIndex] = code;
+        return out;
+    }
+
+    size_t cobsDecode(const uint8_t *src, size_t len, uint8_t *dst)
+    {
+        size_t in = 0;
+        size_t out = 0;
+
+        while(in < len)
+        {
+            uint8_t code = src[in++];
+            if(code == 0 || in + code - 1 > len)
+            {
+                return 0;                                                       // Zero inside a frame, or truncated block
+            }
+            for(uint8_t i = 1; i < code; i++)
+            {
+                dst[out++] = src[in++];
+            }
+            if(code != 0xFF && in < len)
+            {
+                dst[out++] = 0;                                                 // Implicit zero between blocks
+            }
+        }
+        return out;
+    }
+
+    size_t buildFrame(const Frame &frame, uint8_t *out)
+    {
+        uint8_t raw[MAX_FRAME];
+        size_t len = 0;
+
+        raw[len++] = frame.seq;
+        raw[len++] = frame.code;
+        memcpy(raw + len, frame.payload, frame.len);
+        len += frame.len;
+        uint16_t crc = crc16(raw, len);
+        raw[len++] = (uint8_t)(crc & 0xFF);
+        raw[len++] = (uint8_t)(crc >> 8);
+
+        out[0] = 0x00;                                                          // Leading delimiter flushes any stray text
+        size_t encoded = cobsEncode(raw, len, out + 1);
+        out[encoded + 1] = 0x00;
+        return encoded + 2;
+    }
+
+    int32_t argValue(const Frame &frame)
+    {
+        uint32_t value = 0;
+        for(uint8_t i = 0; i < frame.len && i < 4; i++)
+        {
+            value |= (uint32_t)frame.payload[i] << (8 * i);
+        }
+        if(frame.len > 0 && frame.len < 4 && (frame.payload[frame.len - 1] & 0x80))
+        {
+            value |= 0xFFFFFFFFu << (8 * frame.len);                            // Sign-extend short arguments
+        }
+        return (int32_t)value;
+    }
+
+    int FrameReader::push(uint8_t byte, Frame &frame)
+    {
+        if(byte != 0x00)
+        {
+            if(len < MAX_ENCODED)
+            {
+                buf[len++] = byte;
+            }
+            else
+            {
+                overflow = true;                                                // Keep reading until the delimiter
+            }
+            return 0;
+        }
+
+        size_t encodedLen = len;                                                // Delimiter: decode what we have
+        bool tooLong = overflow;
+        len = 0;
+        overflow = false;
+
+        if(encodedLen == 0)
+        {
+            return 0;                                                           // Empty frame (back-to-back delimiters)
+        }
+        if(tooLong)
+        {
+            return -1;
+        }
+
+        uint8_t raw[MAX_ENCODED];
+        size_t rawLen = cobsDecode(buf, encodedLen, raw);
+        if(rawLen < 4 || rawLen > MAX_FRAME)
+        {
+            return -1;
+        }
+
+        uint16_t crc = (uint16_t)raw[rawLen - 2] | ((uint16_t)raw[rawLen - 1] << 8);
+        if(crc16(raw, rawLen - 2) != crc)
+        {
+            return -1;
+        }
+
+        frame.seq = raw[0];
+        frame.code = raw[1];
+        frame.len = (uint8_t)(rawLen - 4);
+        memcpy(frame.payload, raw + 2, frame.len);
+        return 1;
+    }
+}
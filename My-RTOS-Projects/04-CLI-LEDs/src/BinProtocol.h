@@ -0,0 +1,50 @@
+/**
+ * Joel Brigida
+ * October 18, 2026
+ * Binary control protocol for the CLI (entered with the `binmode` text command).
+ * Every frame is COBS encoded (no 0x00 bytes inside) & terminated by 0x00:
+ *     request:  [seq][opcode][arg: 0, 1, 2 or 4 bytes, signed little-endian][CRC16]
+ *     response: [seq][status][payload: 0..MAX_PAYLOAD bytes][CRC16]
+ * CRC16 is CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF) over everything before it.
+ * Responses are also preceded by a 0x00, so stray text on the line can never merge into a
+ * frame. The host may send many requests without waiting: each response echoes its `seq`.
+ * This file has no Arduino dependencies so the framing can be reused by host tools.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace BinProtocol
+{
+    enum { MAX_PAYLOAD = 80 };                                                  // Fits 1 CLI text line (Message::msg)
+    enum { MAX_FRAME = MAX_PAYLOAD + 4 };                                       // seq + code + payload + CRC16
+    enum { MAX_ENCODED = MAX_FRAME + (MAX_FRAME / 254) + 3 };                   // COBS overhead + 2 delimiters
+
+    struct Frame
+    {
+        uint8_t seq;                                                            // Echoed back in the response
+        uint8_t code;                                                           // Opcode (request) or status (response)
+        uint8_t len;                                                            // Payload length
+        uint8_t payload[MAX_PAYLOAD];
+    };
+
+    uint16_t crc16(const uint8_t *data, size_t len);
+    size_t cobsEncode(const uint8_t *src, size_t len, uint8_t *dst);            // Returns encoded length
+    size_t cobsDecode(const uint8_t *src, size_t len, uint8_t *dst);            // Returns 0 if malformed
+
+    size_t buildFrame(const Frame &frame, uint8_t *out);                        // out[MAX_ENCODED]: 0x00 + COBS + 0x00
+    int32_t argValue(const Frame &frame);                                       // Sign-extended integer argument
+
+    class FrameReader                                                           // Byte-at-a-time frame assembler
+    {
+    public:
+        int push(uint8_t byte, Frame &frame);                                   // 1 = frame ready, -1 = bad frame, 0 = more
+
+    private:
+        uint8_t buf[MAX_ENCODED];
+        size_t len = 0;
+        bool overflow = false;
+    };
+}
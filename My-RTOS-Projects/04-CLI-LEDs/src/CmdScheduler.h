@@ -0,0 +1,175 @@
+/**
+ * Joel Brigida
+ * October 18, 2026
+ * Fixed-size timer queue for the `at` / `every` CLI commands.
+ * Entries live in a static pool & a binary min-heap of pool indices keeps the earliest
+ * deadline on top, so one task can sleep until `peek()->deadline` instead of using 1
+ * software timer or task per entry. Times are plain tick counts compared with wrap-safe
+ * signed math. No heap allocation & no RTOS calls: the owning task does all locking.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+template <size_t Capacity, size_t CmdLen>
+class CmdScheduler
+{
+    static_assert(Capacity <= 255, "heap stores uint8_t pool indices");
+
+public:
+    struct Entry
+    {
+        uint16_t id;                                                            // Handle for `cancel`
+        uint32_t deadline;                                                      // Tick count of the next run
+        uint32_t period;                                                        // 0 = run once (`at`)
+        char cmd[CmdLen];                                                       // CLI command line to run
+    };
+
+    int add(uint32_t deadline, uint32_t period, const char *cmd)                // Returns the new id, or -1 if full
+    {
+        if(count >= Capacity)
+        {
+            return -1;
+        }
+
+        uint8_t slot = 0;
+        while(used[slot])                                                       // Capacity is small: linear scan
+        {
+            slot++;
+        }
+        used[slot] = true;
+
+        Entry &entry = pool[slot];
+        entry.id = nextId++;
+        if(nextId == 0)
+        {
+            nextId = 1;                                                         // 0 is never a valid id
+        }
+        entry.deadline = deadline;
+        entry.period = period;
+        strncpy(entry.cmd, cmd, CmdLen - 1);
+        entry.cmd[CmdLen - 1] = '\0';
+
+        heap[count] = slot;
+        siftUp(count);
+        count++;
+        return entry.id;
+    }
+
+    bool cancel(uint16_t id)
+    {
+        for(size_t i = 0; i < count; i++)
+        {
+            if(pool[heap[i]].id == id)
+            {
+                removeAt(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const Entry *peek() const                                                   // Earliest deadline, NULL if empty
+    {
+        return (count > 0) ? &pool[heap[0]] : NULL;
+    }
+
+    void fired(uint32_t now)                                                    // Call after running `peek()`
+    {
+        Entry &top = pool[heap[0]];
+        if(top.period == 0)
+        {
+            removeAt(0);
+            return;
+        }
+        top.deadline += top.period;                                             // Drift-free: based on the old deadline
+        if(before(top.deadline, now))
+        {
+            top.deadline = now + top.period;                                    // Fell behind: skip, don't burst
+        }
+        siftDown(0);
+    }
+
+    size_t size() const
+    {
+        return count;
+    }
+
+    const Entry &entry(size_t i) const                                          // Heap order, for listing
+    {
+        return pool[heap[i]];
+    }
+
+    static bool before(uint32_t a, uint32_t b)                                  // Wrap-safe `a < b`
+    {
+        return (int32_t)(a - b) < 0;
+    }
+
+private:
+    void removeAt(size_t i)
+    {
+        used[heap[i]] = false;
+        count--;
+        if(i == count)
+        {
+            return;
+        }
+        heap[i] = heap[count];                                                  // Move the last leaf into the hole
+        siftUp(i);
+        siftDown(i);
+    }
+
+    void siftUp(size_t i)
+    {
+        while(i > 0)
+        {
+            size_t parent = (i - 1) / 2;
+            if(!before(pool[heap[i]].deadline, pool[heap[parent]].deadline))
+            {
+                break;
+            }
+            swap(i, parent);
+            i = parent;
+        }
+    }
+
+    void siftDown(size_t i)
+    {
+        for(;;)
+        {
+            size_t smallest = i;
+            size_t left = 2 * i + 1;
+            size_t right = left + 1;
+            if(left < count && before(pool[heap[left]].deadline, pool[heap[smallest]].deadline))
+            {
+                smallest = left;
+            }
+            if(right < count && before(pool[heap[right]].deadline, pool[heap[smallest]].deadline))
+            {
+                smallest = right;
+            }
+            if(smallest == i)
+            {
+                break;
+            }
+            swap(i, smallest);
+            i = smallest;
+        }
+    }
+
+    void swap(size_t a, size_t b)
+    {
+        uint8_t temp = heap[a];
+        heap[a] = heap[b];
+        heap[b] = temp;
+    }
+
+    Entry pool[Capacity];
+    bool used[Capacity] = {};
+    uint8_t heap[Capacity];                                                     // Pool indices, min-heap on deadline
+    size_t count = 0;
+    uint16_t nextId = 1;
+};
@@ -0,0 +1,141 @@
+/**
+ * Joel Brigida
+ * October 18, 2026
+ * Per-hop latency histograms for the CLI command pipeline (`perf` command).
+ * Every command carries a `LatencyTrace` of CPU cycle counter stamps, filled in as it passes
+ * each task: line received -> `msgRXTask` dequeued it -> handed to the worker -> worker picked
+ * it up -> effect applied. The worker records the whole trace once the effect is applied.
+ * All pipeline tasks run on `app_cpu`, so every stamp comes from the same core's counter.
+ * Cycles are converted to us with the CPU clock at record time: a sample that spans a `cpu`
+ * change is off by the ratio of the 2 clocks. Intervals must be < 2^32 cycles (17s @ 240MHz).
+ * Buckets are powers of 2 in us, so the percentiles are upper bounds, not exact values.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+struct LatencyTrace                                                             // Cycle counts, 0 = not stamped
+{
+    uint32_t rx;                                                                // Line complete: typed, script, scheduler or frame
+    uint32_t parsed;                                                            // `msgRXTask` took it off `msgQueue`
+    uint32_t handed;                                                            // Sent to `ledQueue` / written to `ledParams`
+};
+
+class LatencyStats
+{
+public:
+    enum Hop { HOP_MSG_QUEUE, HOP_DISPATCH, HOP_WORKER_QUEUE, HOP_APPLY, HOP_TOTAL, NUM_HOPS };
+    enum { NUM_BUCKETS = 24 };                                                  // Bucket n: < 2^(n+1) us, last one catches the rest
+
+    static uint32_t now()
+    {
+        return ESP.getCycleCount();
+    }
+
+    void record(const LatencyTrace &trace, uint32_t picked, uint32_t applied)   // Called by the worker after applying
+    {
+        if(trace.rx == 0)
+        {
+            return;                                                             // Defaults set at boot, not a command
+        }
+        uint32_t mhz = getCpuFrequencyMhz();
+        uint32_t us[NUM_HOPS];
+        us[HOP_MSG_QUEUE] = (trace.parsed - trace.rx) / mhz;
+        us[HOP_DISPATCH] = (trace.handed - trace.parsed) / mhz;
+        us[HOP_WORKER_QUEUE] = (picked - trace.handed) / mhz;
+        us[HOP_APPLY] = (applied - picked) / mhz;
+        us[HOP_TOTAL] = (applied - trace.rx) / mhz;
+
+        portENTER_CRITICAL(&lock);                                              // `perf` reads from another task
+        for(int i = 0; i < NUM_HOPS; i++)
+        {
+            hops[i].add(us[i]);
+        }
+        portEXIT_CRITICAL(&lock);
+    }
+
+    void reset()
+    {
+        portENTER_CRITICAL(&lock);
+        memset(hops, 0, sizeof(hops));
+        portEXIT_CRITICAL(&lock);
+    }
+
+    template <class Out>
+    void report(Out &out, const char *title = "Command Latency")                // Table, then the non-empty buckets per hop
+    {
+        static const char *names[NUM_HOPS] = { "msg queue", "dispatch", "worker queue", "apply", "total" };
+
+        portENTER_CRITICAL(&lock);                                              // Snapshot: never format with interrupts masked
+        memcpy(shown, hops, sizeof(shown));
+        portEXIT_CRITICAL(&lock);
+
+        out.printf("\n%s (us): %u Samples\n", title, shown[HOP_TOTAL].count);
+        out.print("Hop               min      avg      max    ~p50    ~p99\n");
+        for(int i = 0; i < NUM_HOPS; i++)
+        {
+            const Histogram &h = shown[i];
+            out.printf("%-12s %7u  %7u  %7u  %6u  %6u\n", names[i], h.count ? h.min : 0,
+                       h.count ? (uint32_t)(h.sum / h.count) : 0, h.max, h.percentile(50), h.percentile(99));
+        }
+        for(int i = 0; i < NUM_HOPS; i++)
+        {
+            out.printf("%-12s", names[i]);
+            for(int b = 0; b < NUM_BUCKETS; b++)
+            {
+                if(shown[i].buckets[b] > 0)
+                {
+                    out.printf(" <%lu:%u", 2UL << b, shown[i].buckets[b]);
+                }
+            }
+            out.print("\n");
+        }
+        out.print("\n");
+    }
+
+private:
+    struct Histogram
+    {
+        uint32_t count;
+        uint32_t min;
+        uint32_t max;
+        uint64_t sum;
+        uint32_t buckets[NUM_BUCKETS];
+
+        void add(uint32_t us)
+        {
+            if(count == 0 || us < min)
+            {
+                min = us;
+            }
+            if(us > max)
+            {
+                max = us;
+            }
+            count++;
+            sum += us;
+            int b = (us < 2) ? 0 : (31 - __builtin_clz(us));                    // floor(log2(us))
+            buckets[(b < NUM_BUCKETS) ? b : (NUM_BUCKETS - 1)]++;
+        }
+
+        uint32_t percentile(uint32_t pct) const                                 // Upper edge of the bucket holding it
+        {
+            uint32_t target = (count * pct + 99) / 100;
+            uint32_t seen = 0;
+            for(int b = 0; b < NUM_BUCKETS; b++)
+            {
+                seen += buckets[b];
+                if(count > 0 && seen >= target)
+                {
+                    return 2UL << b;
+                }
+            }
+            return 0;
+        }
+    };
+
+    Histogram hops[NUM_HOPS] = {};
+    Histogram shown[NUM_HOPS];                                                  // `report()` copy: ~600B off the caller's stack
+    portMUX_TYPE lock = portMUX_INITIALIZER_UNLOCKED;
+};
@@ -0,0 +1,474 @@
+/**
+ * Joel Brigida
+ * October 18, 2026
+ * The 6 LED patterns of `04-CLI-LEDs` (5 drawn live + `play` animations) & the registry that
+ * selects them. See `Patterns.h`.
+ */
+
+#include "Patterns.h"
+#include "LedTables.h"                                                          // lib/LedTables: gamma & hue wheel in flash
+
+LedOutput::LedOutput(StripOutput &strip, uint8_t ledcChannel, uint8_t ledcBits)
+    : strip(strip), channel(ledcChannel), dutyMax((1UL << ledcBits) - 1)
+{
+    fader.begin(ledcChannel);
+}
+
+CRGB *LedOutput::beginFrame()
+{
+    if(captured != NULL)
+    {
+        return captured->leds;
+    }
+    drawing = strip.back();
+    return drawing;
+}
+
+void LedOutput::endFrame(uint8_t brightness)
+{
+    if(captured != NULL)
+    {
+        captured->bright = brightness;
+        return;
+    }
+    strip.present(brightness);
+    lastFrame = drawing;
+    lastBright = brightness;
+}
+
+size_t LedOutput::size() const
+{
+    return strip.size();
+}
+
+void LedOutput::showRGB(const CRGB &color, uint8_t brightness)
+{
+    fill_solid(beginFrame(), size(), color);
+    endFrame(brightness);
+}
+
+void LedOutput::rgbOff()
+{
+    showRGB(CRGB::Black, 0);
+}
+
+void LedOutput::blue(uint8_t value)
+{
+    if(captured != NULL)
+    {
+        captured->blue = value;
+        return;
+    }
+    uint32_t duty = (uint32_t)LedTables::gamma12[value] * dutyMax / LedTables::DUTY_MAX; // Gamma corrected, 255 = full on
+    if(duty == lastDuty)                                                        // Held at 0 / 255, or a slow fade between steps
+    {
+        skipped++;
+        return;
+    }
+    ledcWrite(channel, duty);
+    lastDuty = duty;
+    writes++;
+}
+
+bool LedOutput::blueFadeTo(uint8_t value, uint32_t ms)                          // Linear ramp: ends on the gamma corrected duty
+{
+    if(captured != NULL)
+    {
+        return false;                                                           // Captured patterns fade in software
+    }
+    lastDuty = UINT32_MAX;                                                      // Hardware owns the duty now
+    return fader.fadeTo((uint32_t)LedTables::gamma12[value] * dutyMax / LedTables::DUTY_MAX, ms);
+}
+
+bool LedOutput::blueFading() const
+{
+    return fader.busy();
+}
+
+uint32_t LedOutput::blueFades() const
+{
+    return fader.completed();
+}
+
+uint32_t LedOutput::blueWrites() const
+{
+    return writes;
+}
+
+uint32_t LedOutput::blueSkipped() const
+{
+    return skipped;
+}
+
+void LedOutput::capture(FrameCapture *target)
+{
+    captured = target;
+}
+
+void LedOutput::snapshot(FrameCapture &target) const
+{
+    if(lastFrame != NULL)
+    {
+        memcpy(target.leds, lastFrame, size() * sizeof(CRGB));
+        target.bright = lastBright;
+    }
+    else
+    {
+        fill_solid(target.leds, size(), CRGB::Black);
+        target.bright = 0;
+    }
+
+    uint32_t duty = ledcRead(channel) * LedTables::DUTY_MAX / dutyMax;        // Also correct halfway through a hardware ramp
+    target.blue = 255;
+    for(int level = 0; level < 255; level++)                                    // Inverse gamma: 1st level at or above the duty
+    {
+        if(LedTables::gamma12[level] >= duty)
+        {
+            target.blue = level;
+            break;
+        }
+    }
+}
+
+static CRGB hueColor(uint8_t hue)                                               // Table lookup instead of HSV math every frame
+{
+    LedTables::Rgb color = LedTables::wheel[hue];
+    return CRGB(color.r, color.g, color.b);
+}
+
+/*** Patterns ***/
+
+class ColorWheelFade : public LedPattern                                        // 1: Fade On/Off & cycle through 8 colors
+{
+public:
+    void init(LedOutput &out) override
+    {
+        out.blue(0);
+    }
+
+    void render(LedOutput &out, uint32_t frame, uint32_t dtUs) override
+    {
+        uint32_t bottoms = fade.advance(units(dtUs));
+        hue += 32 * bottoms;                                                    // Only change color at the bottom of the fade
+        if(bottoms > 0)
+        {
+            color = hueColor(hue);                                              // Rotate: Rd-Orng-Yel-Grn-Aqua-Blu-Purp-Pnk
+        }
+        out.showRGB(color, fade.level());
+    }
+
+private:
+    TriangleFade fade = { 65 };
+    uint8_t hue = 0;                                                            // Wraps after 8 colors
+    CRGB color = CRGB::Red;
+};
+
+class PoliceFade : public LedPattern                                            // 2: Fade On/Off Red/Blue
+{
+public:
+    void init(LedOutput &out) override
+    {
+        out.blue(0);
+    }
+
+    void render(LedOutput &out, uint32_t frame, uint32_t dtUs) override
+    {
+        if(fade.advance(units(dtUs)) % 2)                                       // Swap colors while the LED is dark
+        {
+            blueNext = !blueNext;
+        }
+        out.showRGB(blueNext ? CRGB(CRGB::Blue) : CRGB(CRGB::Red), fade.level());
+    }
+
+private:
+    TriangleFade fade = { 65 };
+    bool blueNext = false;
+};
+
+class RainbowCycle : public LedPattern                                          // 3: Rotate colors w/o fade at `bright`, 1 wheel along a strip
+{
+public:
+    void init(LedOutput &out) override
+    {
+        out.blue(0);
+    }
+
+    void render(LedOutput &out, uint32_t frame, uint32_t dtUs) override
+    {
+        hue = fmodf(hue + units(dtUs), 255.0f);
+        CRGB *leds = out.beginFrame();
+        size_t count = out.size();
+        for(size_t i = 0; i < count; i++)                                       // LED 0 has `hue`, the rest spread over the wheel
+        {
+            leds[i] = hueColor((uint8_t)((uint32_t)hue + i * 256 / count));
+        }
+        out.endFrame(params.bright);
+    }
+
+private:
+    float hue = 0;
+};
+
+class BlueFade : public LedPattern                                              // 4: Blue LED (Pin 13) fades on/off
+{
+public:
+    void init(LedOutput &out) override
+    {
+        out.rgbOff();
+        hardware = true;
+        rising = true;
+        ramp(out);                                                              // Falls back to software if it can't start
+    }
+
+    void render(LedOutput &out, uint32_t frame, uint32_t dtUs) override
+    {
+        if(hardware)                                                            // Woken by a fade end or a command
+        {
+            if(!out.blueFading())
+            {
+                rising = !rising;
+                ramp(out);
+            }
+            return;
+        }
+        fade.advance(units(dtUs));
+        out.blue(fade.level());
+    }
+
+    uint32_t idleMs() const override
+    {
+        return hardware ? IDLE_FOREVER : IDLE_NONE;                             // Hardware: sleep until the ramp ends
+    }
+
+private:
+    void ramp(LedOutput &out)                                                   // 1 half cycle at the same speed as software
+    {
+        uint32_t rampMs = (uint32_t)(255.0f * 1000.0f / params.rate());
+        hardware = out.blueFadeTo(rising ? 255 : 0, rampMs);
+    }
+
+    TriangleFade fade = { 65 };
+    bool hardware = false;
+    bool rising = true;
+};
+
+class BlueBlink : public LedPattern                                             // 5: Blue LED (Pin 13) toggles every `delay` ms
+{
+public:
+    void init(LedOutput &out) override
+    {
+        out.rgbOff();
+    }
+
+    void render(LedOutput &out, uint32_t frame, uint32_t dtUs) override
+    {
+        elapsedUs += dtUs;
+        if(elapsedUs < periodUs())
+        {
+            return;
+        }
+        on = ((elapsedUs / periodUs()) % 2) ? !on : on;
+        elapsedUs %= periodUs();                                                // Keep the remainder: no drift
+        out.blue(on ? 255 : 0);
+    }
+
+    uint32_t idleMs() const override                                            // Sleep until the next toggle
+    {
+        return (periodUs() - elapsedUs) / 1000;
+    }
+
+private:
+    uint32_t periodUs() const
+    {
+        return ((params.stepMs > 0) ? params.stepMs : 1) * 1000UL;
+    }
+
+
+    uint32_t elapsedUs = 0;
+    bool on = false;
+};
+
+class AnimationPlayer : public LedPattern                                        // 6: `play <file>` frames at the file's rate
+{
+public:
+    void init(LedOutput &out) override
+    {
+        out.blue(0);
+    }
+
+    void render(LedOutput &out, uint32_t frame, uint32_t dtUs) override
+    {
+        if(stream == NULL || !stream->playing())
+        {
+            return;                                                             // Keep the last frame
+        }
+        if(stream->id() != session)                                             // New file: 1st frame right away
+        {
+            session = stream->id();
+            elapsedUs = periodUs();
+        }
+        else
+        {
+            elapsedUs += dtUs;
+        }
+        if(elapsedUs < periodUs())
+        {
+            return;
+        }
+        elapsedUs = (elapsedUs >= 2 * periodUs()) ? 0 : elapsedUs - periodUs(); // A whole frame late: resync instead of bursting
+
+        if(!stream->ready())                                                    // SD fell behind: the last frame stays up
+        {
+            stream->missed();
+            return;
+        }
+        stream->take(out.beginFrame());
+        out.endFrame(params.bright);
+    }
+
+    uint32_t idleMs() const override                                            // Sleep until the next frame is due
+    {
+        if(stream == NULL || !stream->playing())
+        {
+            return IDLE_FOREVER;                                                // `play` wakes the task with a pattern command
+        }
+        return (elapsedUs < periodUs()) ? (periodUs() - elapsedUs) / 1000 : IDLE_NONE;
+    }
+
+    AnimationStream *stream = NULL;
+
+private:
+    uint32_t periodUs() const
+    {
+        return 1000000UL / stream->fps();
+    }
+
+    uint32_t elapsedUs = 0;
+    uint32_t session = 0;
+};
+
+class AllOff : public LedPattern                                                // Any invalid pattern #
+{
+public:
+    void init(LedOutput &out) override
+    {
+        out.rgbOff();
+        out.blue(0);
+    }
+
+    void render(LedOutput &out, uint32_t frame, uint32_t dtUs) override {}
+
+    uint32_t idleMs() const override
+    {
+        return IDLE_FOREVER;                                                    // Nothing to draw until a command
+    }
+};
+
+/*** Crossfade ***/
+
+void blendFrames(CRGB *out, const CRGB *from, const CRGB *to, size_t count, uint8_t fromWeight, uint8_t toWeight)
+{
+    const uint8_t *a = (const uint8_t *)from;                                  // CRGB is 3 packed bytes: 1 flat loop
+    const uint8_t *b = (const uint8_t *)to;
+    uint8_t *dest = (uint8_t *)out;
+    for(size_t i = 0; i < count * sizeof(CRGB); i++)                           // 2 multiplies per channel, no division
+    {
+        dest[i] = blend8(a[i], b[i], fromWeight, toWeight);
+    }
+}
+
+Crossfade::Crossfade(CRGB *fromLeds, CRGB *toLeds)
+{
+    from.leds = fromLeds;
+    to.leds = toLeds;
+}
+
+void Crossfade::start(LedOutput &out, LedPattern &outgoingPattern, LedPattern &incomingPattern, uint32_t ms)
+{
+    if(ms == 0 || &outgoingPattern == &incomingPattern)                         // Same object: e.g. 1 invalid # to another
+    {
+        incoming = NULL;
+        incomingPattern.init(out);
+        return;
+    }
+
+    out.snapshot(from);                                                         // Start from exactly what is showing
+    outgoing = active() ? NULL : &outgoingPattern;                              // Mid-blend: freeze the blend, fade that out
+    memcpy(to.leds, from.leds, out.size() * sizeof(CRGB));
+    to.bright = from.bright;
+    to.blue = from.blue;
+
+    out.capture(&to);
+    incomingPattern.init(out);
+    out.capture(NULL);
+
+    incoming = &incomingPattern;
+    durationUs = ms * 1000;
+    elapsedUs = 0;
+}
+
+void Crossfade::render(LedOutput &out, uint32_t frame, uint32_t dtUs)
+{
+    elapsedUs += dtUs;
+    if(outgoing != NULL)
+    {
+        out.capture(&from);
+        outgoing->render(out, frame, dtUs);
+    }
+    out.capture(&to);
+    incoming->render(out, frame, dtUs);
+    out.capture(NULL);
+
+    uint8_t alpha = (elapsedUs >= durationUs) ? 255 : (uint8_t)((uint64_t)elapsedUs * 255 / durationUs);
+    uint8_t fromWeight = (uint8_t)((from.bright * (256 - alpha)) >> 8);        // Each frame's brightness folds into its weight
+    uint8_t toWeight = (uint8_t)((to.bright * (alpha + 1)) >> 8);
+    blendFrames(out.beginFrame(), from.leds, to.leds, out.size(), fromWeight, toWeight);
+    out.endFrame(255);
+    if(!out.blueFading())                                                       // A running hardware ramp finishes on its own
+    {
+        out.blue(blend8(from.blue, to.blue, 255 - alpha, alpha));
+    }
+
+    if(alpha == 255)                                                            // Done: init again on the real LEDs, so
+    {                                                                           // BlueFade can take its hardware ramp back
+        LedPattern *done = incoming;
+        incoming = NULL;
+        outgoing = NULL;
+        done->init(out);
+    }
+}
+
+/*** Registry ***/
+
+static AllOff allOff;
+static ColorWheelFade colorWheelFade;
+static PoliceFade policeFade;
+static RainbowCycle rainbowCycle;
+static BlueFade blueFade;
+static BlueBlink blueBlink;
+static AnimationPlayer animationPlayer;
+
+static LedPattern *const registry[NUM_PATTERNS + 1] =                           // Index = pattern #
+{
+    &allOff,
+    &colorWheelFade,
+    &policeFade,
+    &rainbowCycle,
+    &blueFade,
+    &blueBlink,
+    &animationPlayer
+};
+
+LedPattern &patternFor(int32_t number)
+{
+    if(number < 1 || number > NUM_PATTERNS)
+    {
+        return allOff;
+    }
+    return *registry[number];
+}
+
+void attachAnimation(AnimationStream &stream)
+{
+    animationPlayer.stream = &stream;
+}
@@ -0,0 +1,156 @@
+/**
+ * Joel Brigida
+ * October 18, 2026
+ * LED pattern interface & registry for `RGBcolorWheelTask`.
+ * Each pattern is a self-contained `LedPattern`: it owns its animation state & draws only
+ * through `LedOutput`. The task runs a fixed-rate frame clock & calls `render()` on the
+ * selected pattern every frame with the microseconds since the last one (`esp_timer`).
+ * Patterns move in units per second (`PatternParams::rate()`), so animation speed doesn't
+ * change when frames are late, skipped, or the CPU clock changes: only smoothness does.
+ * Selecting a pattern is 1 array index. A pattern that doesn't need every frame says so with
+ * `idleMs()` & the task sleeps until then, a command, or a hardware fade end (`LedcFade`).
+ * Adding a pattern: write a `LedPattern` subclass in `Patterns.cpp` & add it to `registry`.
+ * `Crossfade` switches patterns smoothly: while it runs, both patterns draw into their own
+ * `FrameCapture` & `blendFrames()` mixes them with 8-bit fixed point weights.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <FastLED.h>
+#include "LedcFade.h"                                                           // lib/LedcFade: LEDC hardware ramps
+#include "StripOutput.h"                                                        // Double-buffered strip, own output task
+#include "Animation.h"                                                          // `play <file>` frames from SD
+
+struct PatternParams                                                            // Set from the CLI, copied to the selected pattern
+{
+    int32_t fade;                                                               // `fade`: brightness or hue change per step
+    int32_t stepMs;                                                             // `delay`: time between animation steps
+    int32_t bright;                                                             // `bright`: fixed brightness (pattern 3)
+
+    float rate() const                                                          // Units per second: `fade` every `delay` ms
+    {
+        return (fade * 1000.0f) / ((stepMs > 0) ? stepMs : 1);
+    }
+};
+
+struct TriangleFade                                                             // 0 -> 255 -> 0 ramp driven by elapsed time
+{
+    float phase;                                                                // 0 - 510: rising below 255, falling above
+
+    uint32_t advance(float units)                                               // Returns # of times the ramp hit bottom
+    {
+        phase += units;
+        uint32_t bottoms = (uint32_t)(phase / 510.0f);                          // Any # of cycles in 1 long frame
+        phase -= bottoms * 510.0f;
+        return bottoms;
+    }
+
+    uint8_t level() const
+    {
+        return (phase <= 255.0f) ? (uint8_t)phase : (uint8_t)(510.0f - phase);
+    }
+};
+
+struct FrameCapture                                                             // A pattern's output, held instead of shown
+{
+    CRGB *leds;                                                                 // `LedOutput::size()` LEDs, kept between frames
+    uint8_t bright;
+    uint8_t blue;                                                               // Blue LED level 0 - 255
+};
+
+class LedOutput                                                                 // The RGB LED / strip (FastLED) & the Blue LED (LEDC)
+{
+public:
+    LedOutput(StripOutput &strip, uint8_t ledcChannel, uint8_t ledcBits);
+
+    CRGB *beginFrame();                                                         // Back buffer: draw all `size()` LEDs
+    void endFrame(uint8_t brightness);                                          // Queue it for output, never blocks
+    size_t size() const;
+    void showRGB(const CRGB &color, uint8_t brightness);                        // Whole strip 1 color
+    void rgbOff();
+    void blue(uint8_t value);                                                   // 0 - 255, scaled to the LEDC resolution
+    bool blueFadeTo(uint8_t value, uint32_t ms);                                // Hardware ramp, false = fade in software
+    bool blueFading() const;
+    uint32_t blueFades() const;                                                 // Hardware ramps finished so far
+    uint32_t blueWrites() const;                                                // `ledcWrite()` calls that changed the duty
+    uint32_t blueSkipped() const;                                               // `blue()` calls with the duty already set
+
+    void capture(FrameCapture *target);                                         // Draw into `target`, NULL = back to the LEDs
+    void snapshot(FrameCapture &target) const;                                  // Copy what the LEDs show right now
+
+private:
+    StripOutput &strip;
+    uint8_t channel;
+    uint32_t dutyMax;
+    uint32_t lastDuty = UINT32_MAX;                                             // Unknown until the 1st write or after a ramp
+    uint32_t writes = 0;
+    uint32_t skipped = 0;
+    FrameCapture *captured = NULL;
+    CRGB *drawing = NULL;                                                       // From `beginFrame()`
+    CRGB *lastFrame = NULL;                                                     // Last presented: intact until the next `beginFrame()`
+    uint8_t lastBright = 0;
+    LedcFade fader;                                                             // Fade-end notifies the task that built this
+};
+
+class LedPattern
+{
+public:
+    enum : uint32_t { IDLE_NONE = 0, IDLE_FOREVER = 0xFFFFFFFF };
+
+    virtual void init(LedOutput &out) = 0;                                      // Just selected: turn off the LED it doesn't use
+    virtual void render(LedOutput &out, uint32_t frame, uint32_t dtUs) = 0;     // Every frame, `dtUs` since the last one
+
+    virtual void setParams(const PatternParams &newParams)
+    {
+        params = newParams;
+    }
+
+    virtual uint32_t idleMs() const                                             // After `render()`: time until the next frame is needed
+    {
+        return IDLE_NONE;                                                       // Default: every frame
+    }
+
+protected:
+    float units(uint32_t dtUs) const                                            // Distance to move this frame
+    {
+        return params.rate() * (dtUs / 1000000.0f);
+    }
+
+    PatternParams params = { 5, 30, 250 };
+};
+
+inline uint8_t blend8(uint8_t a, uint8_t b, uint8_t weightA, uint8_t weightB)  // weightA + weightB <= 255: exact at 0 & 255
+{
+    return (uint8_t)((a * weightA + b * weightB + 255) >> 8);
+}
+
+void blendFrames(CRGB *out, const CRGB *from, const CRGB *to, size_t count, uint8_t fromWeight, uint8_t toWeight);
+
+class Crossfade                                                                 // Blends the outgoing pattern into the incoming one
+{
+public:
+    Crossfade(CRGB *fromLeds, CRGB *toLeds);                                    // 2 scratch frames of `LedOutput::size()` LEDs
+
+    void start(LedOutput &out, LedPattern &outgoing, LedPattern &incoming, uint32_t ms); // 0 ms: switch at once
+    void render(LedOutput &out, uint32_t frame, uint32_t dtUs);                 // Both patterns, then 1 blended frame
+
+    bool active() const
+    {
+        return incoming != NULL;
+    }
+
+private:
+    FrameCapture from;
+    FrameCapture to;
+    LedPattern *outgoing = NULL;                                                // NULL: `from` is a frozen snapshot
+    LedPattern *incoming = NULL;                                                // NULL: no transition running
+    uint32_t durationUs = 0;
+    uint32_t elapsedUs = 0;
+};
+
+static const int NUM_PATTERNS = 6;                                              // Valid patterns are 1 - NUM_PATTERNS
+static const int PLAY_PATTERN = 6;                                              // Selected by `play <file>`
+
+LedPattern &patternFor(int32_t number);                                         // Anything out of range is "all off"
+void attachAnimation(AnimationStream &stream);                                  // Pattern 6 shows frames from `stream`
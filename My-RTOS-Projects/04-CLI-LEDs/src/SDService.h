@@ -0,0 +1,188 @@
+/**
+ * Joel Brigida
+ * October 18, 2026
+ * Request queue for the SD card worker (`SDCardTask`), the only task that runs file commands.
+ * Callers fill in an `SDRequest` (a typed op, a path & an argument) & `submit()` it without
+ * waiting, so the CLI & LED tasks never sit behind a slow card. The worker takes requests in
+ * order & completes each one with an `SDResult` (status, bytes, queue wait & run time):
+ *     `done` callback:  runs on the worker right after the op, e.g. to print the result
+ *     `notify` task:    gets `*result` filled in & a task notification (see `call()`)
+ * `run` scripts & `play` animations still stream their own open files: FATFS locks the
+ * volume per call, so their reads interleave with the worker's ops.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include "LatencyStats.h"
+
+enum SDOp : uint8_t
+{
+    SD_OP_MOUNT   = 0,                                                          // Mount only: every op mounts first if needed
+    SD_OP_LSDIR   = 1,                                                          // `lsdir <dir>`
+    SD_OP_MKDIR   = 2,                                                          // `mkdir <dir>`
+    SD_OP_RMDIR   = 3,                                                          // `rmdir <dir>`
+    SD_OP_READ    = 4,                                                          // `readfile <file>`
+    SD_OP_WRITE   = 5,                                                          // `writefile <file> <text>`
+    SD_OP_APPEND  = 6,                                                          // `append <file> <text>`
+    SD_OP_RENAME  = 7,                                                          // `rename <from> <to>`
+    SD_OP_REMOVE  = 8,                                                          // `rmfile <file>`
+    SD_OP_USAGE   = 9,                                                          // `lsbytes [fat]`: `fat` = also walk the FAT
+    SD_OP_BENCH   = 10,                                                         // `sdbench [kB]`: arg = test file size in kB
+    SD_OP_LOG     = 11,                                                         // `log <text>`: 1 line into the CLI log
+    SD_OP_LOGSYNC = 12,                                                         // `logsync`: CLI log buffer & length to the card
+    SD_OP_LOGCAT  = 13,                                                         // `logcat [kB]`: print the end of the CLI log
+    NUM_SD_OPS
+};
+
+enum SDStatus : uint8_t
+{
+    SD_ST_OK        = 0,
+    SD_ST_NO_CARD   = 1,                                                        // Mount failed: retried with the next request
+    SD_ST_NOT_FOUND = 2,                                                        // Path can't be opened
+    SD_ST_FAILED    = 3,                                                        // Card refused the op (exists, not empty, full...)
+    SD_ST_BAD_ARG   = 4                                                         // Missing path / text, unknown op
+};
+
+struct SDResult
+{
+    uint8_t status;                                                             // SDStatus
+    uint32_t bytes;                                                             // Read or written, 0 for the others
+    uint32_t waitUs;                                                            // `submit()` -> worker picked it up
+    uint32_t runUs;                                                             // Worker picked it up -> op done
+};
+
+struct SDRequest;
+typedef void (*SDCallback)(const SDRequest &request, const SDResult &result);
+
+struct SDRequest
+{
+    uint8_t op;                                                                 // SDOp
+    char path[64];
+    char arg[80];                                                               // `rename`: new path, `writefile` / `append`: text
+    SDCallback done;                                                            // NULL = no callback
+    TaskHandle_t notify;                                                        // NULL = no notification
+    SDResult *result;                                                           // Filled in before `notify` is notified
+    LatencyTrace trace;                                                         // For `perf`: rx, parsed, handed = queued
+    int64_t queuedUs;                                                           // Set by `submit()`
+};
+
+class SDService
+{
+public:
+    bool begin(UBaseType_t depth)
+    {
+        queue = xQueueCreate(depth, sizeof(SDRequest));
+        return queue != NULL;
+    }
+
+    /*** Caller Side ***/
+
+    bool submit(SDRequest &request, TickType_t wait)                            // false = queue full: nothing was queued
+    {
+        request.trace.handed = LatencyStats::now();
+        request.queuedUs = esp_timer_get_time();
+        if(xQueueSend(queue, (void *)&request, wait) != pdTRUE)
+        {
+            rejectedCount++;
+            return false;
+        }
+        return true;
+    }
+
+    uint8_t call(SDRequest &request, SDResult &result)                          // Blocks the calling task until done: never from the CLI or LED task
+    {
+        request.done = NULL;
+        request.notify = xTaskGetCurrentTaskHandle();
+        request.result = &result;
+        submit(request, portMAX_DELAY);
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);                                // No timeout: the worker writes `result` later
+        return result.status;
+    }
+
+    /*** Worker Side ***/
+
+    bool next(SDRequest &request, TickType_t wait)
+    {
+        if(xQueueReceive(queue, (void *)&request, wait) != pdTRUE)
+        {
+            return false;
+        }
+        pickedUs = esp_timer_get_time();
+        return true;
+    }
+
+    void complete(const SDRequest &request, SDResult &result)                   // After the op ran: stamp, count & hand back
+    {
+        int64_t nowUs = esp_timer_get_time();
+        result.waitUs = (uint32_t)(pickedUs - request.queuedUs);
+        result.runUs = (uint32_t)(nowUs - pickedUs);
+        completedCount++;
+        if(result.status != SD_ST_OK)
+        {
+            failedCount++;
+        }
+        if(result.runUs > maxRun)
+        {
+            maxRun = result.runUs;
+        }
+        if(request.done != NULL)
+        {
+            request.done(request, result);
+        }
+        if(request.notify != NULL)
+        {
+            *request.result = result;
+            xTaskNotifyGive(request.notify);
+        }
+    }
+
+    /*** Stats ***/
+
+    uint32_t completed() const
+    {
+        return completedCount;
+    }
+
+    uint32_t failed() const                                                     // Completed with a status other than OK
+    {
+        return failedCount;
+    }
+
+    uint32_t rejected() const                                                   // `submit()` found the queue full
+    {
+        return rejectedCount;
+    }
+
+    uint32_t maxRunUs() const
+    {
+        return maxRun;
+    }
+
+    uint32_t pending() const
+    {
+        return (queue != NULL) ? uxQueueMessagesWaiting(queue) : 0;
+    }
+
+    static const char *opName(uint8_t op)
+    {
+        static const char *names[NUM_SD_OPS] = { "mount", "lsdir", "mkdir", "rmdir", "readfile",
+                                                 "writefile", "append", "rename", "rmfile", "lsbytes", "sdbench",
+                                                 "log", "logsync", "logcat" };
+        return (op < NUM_SD_OPS) ? names[op] : "?";
+    }
+
+    static const char *statusName(uint8_t status)
+    {
+        static const char *names[] = { "OK", "No Card", "Not Found", "Failed", "Bad Argument" };
+        return (status <= SD_ST_BAD_ARG) ? names[status] : "?";
+    }
+
+private:
+    QueueHandle_t queue = NULL;
+    int64_t pickedUs = 0;                                                       // Worker only
+    volatile uint32_t completedCount = 0;
+    volatile uint32_t failedCount = 0;
+    volatile uint32_t rejectedCount = 0;
+    volatile uint32_t maxRun = 0;
+};
@@ -0,0 +1,183 @@
+/**
+ * Joel Brigida
+ * October 18, 2026
+ * Double-buffered WS2812 strip output. The render task draws into the back buffer & calls
+ * `present()`; a separate output task streams the front buffer out with `FastLED.show()`
+ * (RMT on the ESP32), so only the output task ever waits for the wire. The swap happens
+ * when the output task finishes a frame (vsync). If the render task finishes another frame
+ * before that, it takes the waiting buffer back & redraws it: the newest frame always wins,
+ * the render task never blocks & `replaced()` counts the frames that were never shown.
+ * At 30us per LED a 1000 LED strip takes ~30ms to send, so the strip shows ~33 fps while
+ * patterns still render at the frame clock rate.
+ * `present()` hashes each frame (FNV-1a over the pixels + brightness) & drops it when it
+ * matches the last frame sent: static & slow patterns stop using the wire. `unchanged()`
+ * counts those frames.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <FastLED.h>
+
+class StripOutput
+{
+public:
+    StripOutput(CRGB *buffer0, CRGB *buffer1, size_t numLeds)
+        : count(numLeds)
+    {
+        buffers[0] = buffer0;
+        buffers[1] = buffer1;
+    }
+
+    void begin(CLEDController &strip, BaseType_t core, UBaseType_t priority = 2) // After `FastLED.addLeds()`
+    {
+        controller = &strip;
+        xTaskCreatePinnedToCore(outputTask, "Strip Output", 2048, this, priority, &task, core);
+    }
+
+    CRGB *back()                                                                // Render task: the buffer to draw into
+    {
+        portENTER_CRITICAL(&lock);
+        if(pending >= 0)                                                        // Not sent yet: redraw it with newer content
+        {
+            drawing = pending;
+            pending = -1;
+            replacedFrames++;
+        }
+        else
+        {
+            drawing = (showing == 0) ? 1 : 0;                                   // Never the one on the wire
+        }
+        portEXIT_CRITICAL(&lock);
+        return buffers[drawing];
+    }
+
+    void present(uint8_t brightness)                                            // Render task: hand `back()` to the output task
+    {
+        uint32_t hash = frameHash(buffers[drawing], brightness);                // Outside the lock: O(LEDs)
+
+        portENTER_CRITICAL(&lock);
+        bool same = sentValid && (hash == sentHash);
+        if(!same)
+        {
+            pending = drawing;
+            scale[drawing] = brightness;                                        // Global brightness travels with its frame
+            hashes[drawing] = hash;
+        }
+        portEXIT_CRITICAL(&lock);
+
+        if(same)
+        {
+            unchangedFrames++;                                                  // Already on the strip: nothing to send
+            return;
+        }
+        xTaskNotifyGive(task);
+    }
+
+    size_t size() const
+    {
+        return count;
+    }
+
+    uint32_t shown() const
+    {
+        return shownFrames;
+    }
+
+    uint32_t replaced() const
+    {
+        return replacedFrames;
+    }
+
+    uint32_t unchanged() const                                                  // Presented but identical to the last frame sent
+    {
+        return unchangedFrames;
+    }
+
+    uint32_t fps() const                                                        // Frames sent in the last full second
+    {
+        return lastFps;
+    }
+
+    uint32_t showUs() const                                                     // Time the last frame took on the wire
+    {
+        return lastShowUs;
+    }
+
+private:
+    uint32_t frameHash(const CRGB *leds, uint8_t brightness) const             // FNV-1a, 32-bit
+    {
+        uint32_t hash = 2166136261UL;
+        const uint8_t *bytes = (const uint8_t *)leds;
+        for(size_t i = 0; i < count * sizeof(CRGB); i++)
+        {
+            hash = (hash ^ bytes[i]) * 16777619UL;
+        }
+        return (hash ^ brightness) * 16777619UL;
+    }
+
+    static void outputTask(void *param)
+    {
+        StripOutput *self = (StripOutput *)param;
+        int64_t windowStart = esp_timer_get_time();
+        uint32_t windowFrames = 0;
+
+        for(;;)
+        {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);                            // Sleep until a frame is presented
+
+            portENTER_CRITICAL(&self->lock);
+            int frame = self->pending;                                          // Swap: the pending frame goes on the wire
+            self->pending = -1;
+            self->showing = frame;
+            if(frame >= 0)
+            {
+                self->sentHash = self->hashes[frame];                           // What the strip will show after this
+                self->sentValid = true;
+            }
+            portEXIT_CRITICAL(&self->lock);
+            if(frame < 0)
+            {
+                continue;                                                       // Taken back by `back()` before we got here
+            }
+
+            int64_t start = esp_timer_get_time();
+            self->controller->setLeds(self->buffers[frame], self->count);
+            FastLED.show(self->scale[frame]);                                   // Blocks this task only
+            int64_t end = esp_timer_get_time();
+
+            portENTER_CRITICAL(&self->lock);
+            self->showing = -1;
+            portEXIT_CRITICAL(&self->lock);
+
+            self->lastShowUs = (uint32_t)(end - start);
+            self->shownFrames++;
+            windowFrames++;
+            if(end - windowStart >= 1000000)
+            {
+                self->lastFps = windowFrames;
+                windowFrames = 0;
+                windowStart = end;
+            }
+        }
+    }
+
+    CRGB *buffers[2];
+    uint8_t scale[2] = { 255, 255 };
+    uint32_t hashes[2] = { 0, 0 };
+    uint32_t sentHash = 0;                                                      // Last frame handed to `FastLED.show()`
+    bool sentValid = false;                                                     // Nothing sent yet: never skip
+    size_t count;
+    int drawing = 0;                                                            // Owned by the render task
+    int pending = -1;                                                           // Presented, not sent yet (-1 = none)
+    int showing = -1;                                                           // On the wire right now (-1 = none)
+    portMUX_TYPE lock = portMUX_INITIALIZER_UNLOCKED;
+
+    CLEDController *controller = NULL;
+    TaskHandle_t task = NULL;
+    volatile uint32_t shownFrames = 0;
+    volatile uint32_t replacedFrames = 0;
+    volatile uint32_t unchangedFrames = 0;
+    volatile uint32_t lastFps = 0;
+    volatile uint32_t lastShowUs = 0;
+};
@@ -7,6 +7,26 @@
  * checked if it is a valid command or not. If not a valid command, the message is printed 
  * to the terminal. If it is a valid command, it's sent to the `RGBcolorTask` to be parsed
  * and the variables controlling LED output are changed inside that task.
+ * Each LED pattern is a separate `LedPattern` class picked from a registry (`Patterns.h`) &
+ * rendered on a fixed 100 fps frame clock. Patterns move by elapsed time (`esp_timer`), so
+ * `fade` / `delay` set a speed in units per second & slow frames don't slow the animation.
+ * `run <file>` streams a command script from the SD card (`wait <ms>`, `repeat N` ... `end`).
+ * `play <file>` streams pre-rendered frames from SD as pattern 6 (`Animation.h`, `tools/led_anim.py`).
+ * `at <ms|+ms> <cmd>` & `every <ms> <cmd>` schedule commands on a single min-heap scheduler task.
+ * The `binmode` command switches the CLI to a COBS framed binary protocol (see `BinProtocol.h`
+ * & `tools/cli_client.py`) that carries the same opcodes for high-rate host automation.
+ * The CLI line is editable (arrows, Home/End, Backspace, Delete) with Up/Down history recall
+ * from a fixed 2kB arena in `lib/SerialCLI`, redrawn with minimal ANSI escape sequences.
+ * Pattern changes crossfade over `xfade <ms>` (0 = instant); `bench [leds]` times the blend.
+ * `perf` prints per-hop latency histograms (cycle counter stamps, see `LatencyStats.h`).
+ * SD file commands (`lscmd` lists them) are queued to `SDCardTask`, which owns the card & prints
+ * each result with its timing (`SDService.h`), so a slow card never stalls the CLI or LEDs.
+ * `log <text>` appends to a buffered log that rotates over 8 preallocated 128kB files in /log
+ * (`lib/RingLog`), so it never uses more than ~1MB of the card. Lines are synced every 1s.
+ * Build with `-D NUM_LEDS=300` (up to ~1000) to drive a WS2812 strip on GPIO_2: patterns draw
+ * into a back buffer while a separate output task sends the front one (`StripOutput.h`).
+ * All terminal output goes through a lock-free TX ring (`lib/SerialOut`) that is drained
+ * by a single output task, so a slow UART never stalls the LED or SD tasks.
  * This program only runs/requires 1 CPU core
  */
 
@@ -15,6 +35,18 @@
 #include "SPI.h" // can be <SPI.h>
 #include "FS.h"
 #include "SD.h"
+#include "SerialOut.h"                                                          // lib/SerialOut: non-blocking TX ring
+#include "SerialCLI.h"                                                          // lib/SerialCLI: line assembly & echo
+#include "WaitSet.h"                                                            // lib/WaitSet: block on queues & serial RX
+#include "BinProtocol.h"                                                        // COBS + CRC16 framing for `binmode`
+#include "CmdScheduler.h"                                                       // Min-heap timer queue for `at` / `every`
+#include "SeqLock.h"                                                            // lib/SeqLock: latest-value mailbox for LED parameters
+#include "LatencyStats.h"                                                       // Per-hop command latency for `perf`
+#include "SDService.h"                                                          // Request queue for the SD card worker
+#include "BlockReader.h"                                                        // lib/BlockReader: block-aligned file range streaming
+#include "SDBench.h"                                                            // lib/SDBench: block size sweep for `sdbench`
+#include "RingLog.h"                                                            // lib/RingLog: rotating, preallocated log files
+#include "Patterns.h"                                                           // LED pattern interface & registry
 
 #if CONFIG_FREERTOS_UNICORE
     static const BaseType_t app_cpu = 0;
@@ -30,13 +62,23 @@
 #define BLUE_LED 13                                                             // Pin 13 is On-Board Blue LED
 #define COLOR_ORDER GRB                                                         // RGB LED in top right corner
 #define CHIPSET WS2812                                                          // Chipset for On-Board RGB LED
-#define NUM_LEDS 1                                                              // Only 1 RGB LED on the ESP32 Thing Plus
-#define NUM_PATTERNS 5                                                          // Total number of LED patterns
-CRGB leds[NUM_LEDS];                                                            // Array for RGB LED on GPIO_2
+#ifndef NUM_LEDS
+#define NUM_LEDS 1                                                              // 1 RGB LED on the Thing Plus: `-D NUM_LEDS=300` for a strip
+#endif
+static CRGB frameA[NUM_LEDS];                                                   // Front & back buffers for the RGB LED / strip on GPIO_2
+static CRGB frameB[NUM_LEDS];
+static StripOutput strip(frameA, frameB, NUM_LEDS);                             // Output task sends 1 while patterns draw the other
+static CRGB fadeFrom[NUM_LEDS];                                                 // `Crossfade` captures: outgoing & incoming pattern
+static CRGB fadeTo[NUM_LEDS];
+static CRGB playA[NUM_LEDS];                                                    // `play`: SD reader decodes 1 while the LED task shows the other
+static CRGB playB[NUM_LEDS];
+static AnimationStream animation(playA, playB, NUM_LEDS);
+static const uint32_t StripMaxMilliamps = 500;                                  // FastLED dims whole frames to stay in a USB budget
 
 static const int LEDCchan = 0;                                                  // use LEDC Channel 0 for Blue LED
 static const int LEDCtimer = 12;                                                // 12-bit precision LEDC timer
 static const int LEDCfreq = 5000;                                               // 5000 Hz LEDC base freq.
+static const uint32_t FrameMs = 10;                                             // LED frame clock: 100 frames / second
 
 static const uint8_t BUF_LEN = 255;                                             // Buffer Length setting for user CLI terminal
 static const char delayCmd[] = "delay ";                                        // STRLEN = 6: delay command definition
@@ -46,785 +88,1498 @@ static const char brightCmd[] = "bright ";
 static const char cpuCmd[] = "cpu ";                                            // STRLEN = 4: cpu speed control command
 static const char getValues[] = "values";                                       // STRLEN = 6: show values of all user variables
 static const char getFreq[] = "freq";                                           // STRLEN = 4: show values for freq
+static const char binModeCmd[] = "binmode";                                     // STRLEN = 7: switch CLI to binary frames
+static const char runCmd[] = "run ";                                            // STRLEN = 4: run a command script from SD
+static const char stopCmd[] = "stop";                                           // STRLEN = 4: abort the running script & animation
+static const char playCmd[] = "play ";                                          // STRLEN = 5: stream an animation file from SD
+static const char waitDirective[] = "wait ";                                    // STRLEN = 5: script only: pause xxx ms
+static const char repeatDirective[] = "repeat ";                                // STRLEN = 7: script only: repeat block N times
+static const char endDirective[] = "end";                                       // STRLEN = 3: script only: end of repeat block
+static const char atCmd[] = "at ";                                              // STRLEN = 3: `at <ms|+ms> <command>`
+static const char everyCmd[] = "every ";                                        // STRLEN = 6: `every <ms> <command>`
+static const char cancelCmd[] = "cancel ";                                      // STRLEN = 7: cancel a scheduled command by id
+static const char jobsCmd[] = "jobs";                                           // STRLEN = 4: list scheduled commands
+static const char perfCmd[] = "perf";                                           // STRLEN = 4: command latency per hop (`perf reset` clears)
+static const char xfadeCmd[] = "xfade ";                                        // STRLEN = 6: pattern crossfade time in ms (0 = off)
+static const char benchCmd[] = "bench";                                         // STRLEN = 5: time the crossfade blend (`bench [leds]`)
+static const int BenchMaxLeds = 1000;
 
 static const char sdListCmds[] = "lscmd";                                       // STRLEN = 5: prints a list of SD commands (from msgQueue)
-static const char sdListDir[] = "lsdir ";                                       // STRLEN = 6: List subdirectories under given argument
-static const char sdCreateDir[] = "mkdir ";                                     
-static const char sdDeleteDir[] = "rmdir ";
-static const char sdReadFile[] = "readfile ";
-static const char sdWriteFile[] = "writefile ";
-static const char sdAppendFile[] = "append ";
-static const char sdRenameFile[] = "rename ";
-static const char sdDeleteFile[] = "rmfile ";
-static const char sdUsedSpace[] = "lsbytes";
+static const char sdListDir[] = "lsdir";                                        // STRLEN = 5: list a directory (`lsdir` alone = root)
+static const char sdCreateDir[] = "mkdir ";                                     // STRLEN = 6: `mkdir <dir>`
+static const char sdDeleteDir[] = "rmdir ";                                     // STRLEN = 6: `rmdir <dir>` (must be empty)
+static const char sdReadFile[] = "readfile ";                                   // STRLEN = 9: `readfile <file> [head N | tail N | <offset> [bytes]]`
+static const char sdWriteFile[] = "writefile ";                                 // STRLEN = 10: `writefile <file> <text>` (replaces the file)
+static const char sdAppendFile[] = "append ";                                   // STRLEN = 7: `append <file> <text>` (adds 1 line)
+static const char sdRenameFile[] = "rename ";                                   // STRLEN = 7: `rename <from> <to>`
+static const char sdDeleteFile[] = "rmfile ";                                   // STRLEN = 7: `rmfile <file>`
+static const char sdUsedSpace[] = "lsbytes";                                    // STRLEN = 7: card size & log usage, `lsbytes fat`: + used space
+static const char sdBenchCmd[] = "sdbench";                                     // STRLEN = 7: SD speed per block size (`sdbench [kB]`)
+static const uint32_t SDBenchMaxKB = 65536;
+static const char logCmd[] = "log ";                                            // STRLEN = 4: `log <text>`: 1 timestamped line into `CliLogDir`
+static const char logSyncCmd[] = "logsync";                                     // STRLEN = 7: CLI log to the card now
+static const char logCatCmd[] = "logcat";                                       // STRLEN = 6: `logcat [kB]`: last kB of the CLI log (default 4)
+static const char CliLogDir[] = "/log";
+static const uint8_t CliLogSegments = 8;                                        // Files, reused round-robin
+static const uint32_t CliLogSegmentBytes = 128 * 1024;                          // Each preallocated once, on its 1st use
+static const uint32_t CliLogSyncMs = 1000;                                      // Max age of a line that isn't on the card yet
+
+static SerialOut<64, 32> serialOut;                                             // 2kB TX ring drained by 1 output task
+static volatile bool binaryMode = false;                                        // true: CLI speaks `BinProtocol` frames
+static volatile bool scriptAbort = false;                                       // Set by `stop` to end the running script
+static volatile bool playAbort = false;                                         // Set by `stop` & `play` to end the running animation
 
 static QueueHandle_t msgQueue;                                                  // Queue for CLI messages
 static QueueHandle_t ledQueue;                                                  // Queue to LED commands
-static QueueHandle_t sdQueue;                                                   // Queue to handle SD card commands
+static SDService sdService;                                                     // Typed requests for `SDCardTask`, the card's only user
+static QueueHandle_t scriptQueue;                                               // Queue of script paths for `scriptTask`
+static QueueHandle_t playQueue;                                                 // Queue of animation paths for `playTask`
+static QueueHandle_t schedQueue;                                                // `at` / `every` / `cancel` / `jobs` for `schedulerTask`
+static const int SchedSize = 16;                                                // Max pending scheduled commands
 static const int QueueSize = 5;                                                 // 5 elements in any Queue
+static WaitSet<0> cliEvents;                                                    // Serial RX wakes `userCLITask`
+static WaitSet<1> msgEvents;                                                    // `msgQueue` wakes `msgRXTask`
+static LatencyStats latency;                                                    // Filled by the workers, printed by `perf`
+static LatencyStats sdLatency;                                                  // Same hops for SD requests, printed by `perf` too
+static RingLog<4096, 16> cliLog;                                                // `log` lines: only `SDCardTask` writes it
+static BlockReader<4096> blockReader;                                           // `readfile` & `logcat`: only `SDCardTask` reads
+static uint32_t rxStamp = 0;                                                    // Cycle count when `userCLITask` woke for the bytes
+static TaskHandle_t ledTask = NULL;                                             // Notified on every LED command: it may be asleep
+static TaskHandle_t scriptRunner = NULL;                                        // Notified by `stop`: ends a script's `wait` early
 
 struct Message                                                                  // Struct for CLI input
 {
     char msg[80];                                                               // User Input
+    uint32_t stamp;                                                             // Cycle count when the line entered the pipeline
+};
+
+static const size_t HistoryBytes = 2048;                                        // Up/Down recall arena: ~100 typical commands
+static SerialCLI<sizeof(Message::msg), 1, SerialOut<64, 32>, HistoryBytes> cli; // Lines always fit a `Message`
+
+enum CmdOp : uint8_t                                                            // Typed opcodes shared by the text & binary CLI
+{
+    OP_PING     = 0x01,                                                         // Binary only: no-op (throughput tests)
+    OP_FADE     = 0x10,                                                         // `fade xxx`
+    OP_DELAY    = 0x11,                                                         // `delay xxx`
+    OP_PATTERN  = 0x12,                                                         // `pattern xxx`
+    OP_BRIGHT   = 0x13,                                                         // `bright xxx`
+    OP_CPU      = 0x14,                                                         // `cpu xxx`
+    OP_VALUES   = 0x15,                                                         // `values`
+    OP_FREQ     = 0x16,                                                         // `freq`: binary response carries 3 x int32 MHz
+    OP_XFADE    = 0x17,                                                         // `xfade xxx`
+    OP_BENCH    = 0x18,                                                         // `bench [xxx]`: LED count, 0 = 300
+    OP_TEXT     = 0x20,                                                         // Binary only: payload is a text command line
+    OP_TEXTMODE = 0x21                                                          // Binary only: return to the text CLI
+};
+
+enum CmdStatus : uint8_t                                                        // Status byte of every binary response
+{
+    ST_OK       = 0x00,
+    ST_BAD_OP   = 0x01,                                                         // Unknown opcode
+    ST_BAD_ARG  = 0x02,                                                         // Argument out of range
+    ST_BUSY     = 0x03                                                          // Destination queue full: resend later
 };
 
 struct Command                                                                  // Sent from `msgRXTask` to `RGBcolorWheelTask`
 {
-    char cmd[25];
+    uint8_t op;                                                                 // CmdOp: only 1-shot actions (`cpu`, `values`, `freq`)
     int amount;
+    LatencyTrace trace;
 };
 
-struct SDCommand                                                                // Sent from `msgRXTask` to `SDCardTask`
+struct LedParams                                                                // Values set by `fade`, `delay`, `pattern`, `bright`, `xfade`
 {
-    char cmd[25];
-    char msg[80];                                                               // default length of Bash Terminal Line
+    int32_t fade;
+    int32_t delayMs;
+    int32_t pattern;
+    int32_t bright;
+    int32_t xfadeMs;
+    LatencyTrace trace;                                                         // Of the newest write only: older ones were coalesced
 };
 
-void ledcAnalogWrite(uint8_t channel, uint32_t value, uint32_t valueMax = 255)  // 'value' must be between 0 & 'valueMax'
+static SeqLock<LedParams> ledParams(LedParams{5, 30, 1, 250, 250});             // Newest value wins: nothing queues up
+
+struct ScriptReader                                                             // Streams lines from SD through a small buffer
 {
-    uint32_t duty = (4095 / valueMax) * min(value, valueMax);                   // calculate duty cycle: 2^12 - 1 = 4095
-    ledcWrite(channel, duty);                                                   // write duty cycle to LEDC
-}
+    File file;
+    uint8_t buf[64];                                                            // RAM use doesn't grow with script length
+    uint16_t pos = 0;                                                           // Next unread byte in `buf`
+    uint16_t len = 0;                                                           // Valid bytes in `buf`
+
+    uint32_t offset()                                                           // File offset of the next unread byte
+    {
+        return file.position() - len + pos;
+    }
+
+    void seek(uint32_t position)                                                // Used by `repeat` to jump back
+    {
+        file.seek(position);
+        pos = 0;
+        len = 0;
+    }
+
+    bool readLine(char *line, size_t maxLen)                                    // false at end of file
+    {
+        size_t count = 0;
+        for(;;)
+        {
+            if(pos >= len)
+            {
+                len = file.read(buf, sizeof(buf));
+                pos = 0;
+                if(len == 0)
+                {
+                    line[count] = '\0';
+                    return count > 0;                                           // Last line may have no '\n'
+                }
+            }
+            char c = buf[pos++];
+            if(c == '\n')
+            {
+                line[count] = '\0';
+                return true;
+            }
+            if(c != '\r' && count < maxLen - 1)                                 // Long lines are truncated
+            {
+                line[count++] = c;
+            }
+        }
+    }
+};
 
 /***************************************************************************************************************************/
 
-// SD Card Functions (testing)
+// SD Card Functions: only called by `SDCardTask`, the result line is printed by the request's callback
 
-void listDir(fs::FS &fs, const char* dirname, uint8_t levels) 
+uint8_t listDir(fs::FS &fs, const char* dirname, uint8_t levels)
 {
-    Serial.printf("Listing directory: %s\n", dirname);
-
     File root = fs.open(dirname);
     if (!root)
     {
-        Serial.println("Failed to open directory");
-        return;
+        return SD_ST_NOT_FOUND;
     }
     if (!root.isDirectory())
     {
-        Serial.println("Not a directory");
-        return;
+        serialOut.printf("Not a directory: %s\n", dirname);
+        return SD_ST_BAD_ARG;
     }
 
+    serialOut.printf("Listing directory: %s\n", dirname);
     File file = root.openNextFile();
     while (file)
     {
         if (file.isDirectory())
         {
-            Serial.print("  DIR : ");
-            Serial.println(file.name());
+            serialOut.printf("  DIR : %s\n", file.name());
             if (levels)
             {
-                listDir(fs, file.name(), levels - 1);
+                listDir(fs, file.path(), levels - 1);
             }
         }
         else
         {
-            Serial.print("  FILE: ");
-            Serial.print(file.name());
-            Serial.print("  SIZE: ");
-            Serial.println(file.size());
+            serialOut.printf("  FILE: %s  SIZE: %u\n", file.name(), file.size());
         }
         file = root.openNextFile();
     }
+    return SD_ST_OK;
+}
+
+uint8_t createDir(fs::FS &fs, const char* path)
+{
+    return fs.mkdir(path) ? SD_ST_OK : SD_ST_FAILED;
 }
 
-void createDir(fs::FS &fs, const char* path)
+uint8_t removeDir(fs::FS &fs, const char* path)
 {
-    Serial.printf("Creating Dir: %s\n", path);
-    if (fs.mkdir(path))
+    return fs.rmdir(path) ? SD_ST_OK : SD_ST_FAILED;                            // Fails if not empty
+}
+
+uint8_t readFile(fs::FS &fs, const char* path, const char *range, uint32_t &bytes) // range: "", "head N", "tail N" or "<offset> [bytes]"
+{
+    File file = fs.open(path);
+    if (!file || file.isDirectory())
     {
-        Serial.println("Dir created");
+        return SD_ST_NOT_FOUND;
     }
-    else
+
+    uint32_t offset = 0;
+    uint32_t length = BlockReader<4096>::TO_END;
+    uint32_t lines = 0;
+    if(memcmp(range, "head ", 5) == 0)
     {
-        Serial.println("mkdir failed");
+        lines = strtoul(range + 5, NULL, 10);
+        if(lines == 0)
+        {
+            length = 0;                                                         // `head 0` = nothing, like `tail 0` (0 lines = no limit in `stream()`)
+        }
     }
-}
-
-void removeDir(fs::FS &fs, const char* path)
-{
-    Serial.printf("Removing Dir: %s\n", path);
-    if (fs.rmdir(path))
+    else if(memcmp(range, "tail ", 5) == 0)
     {
-        Serial.println("Dir removed");
+        offset = blockReader.tailOffset(file, strtoul(range + 5, NULL, 10));
     }
-    else
+    else if(range[0] != '\0')
     {
-        Serial.println("rmdir failed");
+        char *next;
+        offset = strtoul(range, &next, 10);
+        if(*next != '\0')
+        {
+            length = strtoul(next, NULL, 10);
+        }
     }
+
+    serialOut.printf("Read from file %s (%u bytes) @ %u:\n", path, (uint32_t)file.size(), offset);
+    bytes = blockReader.stream(file, offset, length, lines, [](const char *data, size_t len)
+    {
+        serialOut.writeWait(data, len);                                         // Bulk dump: wait for ring space instead of dropping
+    });
+    file.close();
+
+    uint32_t readUs = blockReader.lastReadUs();
+    serialOut.printf("\n%u bytes: %uus reading SD (%ukB/s), %uus with serial output\n", bytes, readUs,
+                     readUs ? (uint32_t)((uint64_t)bytes * 1000000 / 1024 / readUs) : 0, blockReader.lastTotalUs());
+    return SD_ST_OK;
 }
 
-void readFile(fs::FS &fs, const char* path)
+uint8_t writeFile(fs::FS &fs, const char* path, const char * message, const char *mode, uint32_t &bytes)
 {
-    Serial.printf("Reading file: %s\n", path);
-
-    File file = fs.open(path);
+    File file = fs.open(path, mode);                                            // FILE_WRITE truncates, FILE_APPEND adds
     if (!file)
     {
-        Serial.println("Failed to open file for reading");
-        return;
-    }
-
-    Serial.print("Read from file: ");
-    while (file.available())
-    {
-        Serial.write(file.read());
+        return SD_ST_NOT_FOUND;
     }
+    size_t len = strlen(message);
+    bytes = file.write((const uint8_t *)message, len);
     file.close();
+    return (bytes == len) ? SD_ST_OK : SD_ST_FAILED;
 }
 
-void writeFile(fs::FS &fs, const char* path, const char * message)
+uint8_t renameFile(fs::FS &fs, const char* path1, const char* path2)
 {
-    Serial.printf("Writing file: %s\n", path);
-
-    File file = fs.open(path, FILE_WRITE);
-    if (!file)
+    if (!fs.exists(path1))
     {
-        Serial.println("Failed to open file for writing");
-        return;
+        return SD_ST_NOT_FOUND;
     }
-    if (file.print(message))
+    return fs.rename(path1, path2) ? SD_ST_OK : SD_ST_FAILED;
+}
+
+uint8_t deleteFile(fs::FS &fs, const char* path)
+{
+    if (!fs.exists(path))
     {
-        Serial.println("File written");
+        return SD_ST_NOT_FOUND;
     }
-    else
+    return fs.remove(path) ? SD_ST_OK : SD_ST_FAILED;
+}
+
+/*************************************************************************************************************************/
+
+/*** User CLI Start ***/                                                        /** Creates A Node dropped into The msgQueue ***/
+
+void notifyLedTask()                                                            // Idle patterns sleep until a command arrives
+{
+    if(ledTask != NULL)                                                         // NULL until `setup()` creates it
     {
-        Serial.println("Write failed");
+        xTaskNotifyGive(ledTask);
     }
-    file.close();
 }
 
-void appendFile(fs::FS &fs, const char* path, const char* message)
+uint8_t dispatchCommand(uint8_t op, int32_t arg, TickType_t wait, LatencyTrace trace) // Validate & apply 1 LED command (text or binary)
 {
-    Serial.printf("Appending to file: %s\n", path);
+    Command someCmd;
 
-    File file = fs.open(path, FILE_APPEND);
-    if (!file)
+    arg = abs(arg);                                                             // No command takes a negative value
+    if(op == OP_FADE && (arg <= 0 || arg > 128))
     {
-        Serial.println("Failed to open file for appending");
-        return;
+        serialOut.println("Value Must Be Between 1 & 128");
+        serialOut.println("Returning....");
+        return ST_BAD_ARG;
     }
-    if (file.print(message))
+    if(op == OP_DELAY && arg <= 0)
     {
-        Serial.println("Message appended");
+        serialOut.println("Value Must Be > 0");
+        serialOut.println("Returning....");
+        return ST_BAD_ARG;
     }
-    else
+    if(op == OP_CPU && arg != 240 && arg != 160 && arg != 80)
     {
-        Serial.println("Append failed");
+        serialOut.println("Invalid Input: Must Be 240, 160, or 80Mhz");
+        serialOut.println("Returning....\n");
+        return ST_BAD_ARG;
     }
-    file.close();
-}
-
-void renameFile(fs::FS &fs, const char* path1, const char* path2)
-{
-    Serial.printf("Renaming file %s to %s\n", path1, path2);
-    if (fs.rename(path1, path2))
+    if(op == OP_XFADE && arg > 10000)
     {
-        Serial.println("File renamed");
+        serialOut.println("Value Must Be 0 - 10000ms");
+        serialOut.println("Returning....");
+        return ST_BAD_ARG;
     }
-    else
+    if(op == OP_BENCH && arg > BenchMaxLeds)
     {
-        Serial.println("Rename failed");
+        serialOut.printf("Value Must Be 0 - %d LEDs\n", BenchMaxLeds);
+        serialOut.println("Returning....");
+        return ST_BAD_ARG;
     }
-}
-
-void deleteFile(fs::FS &fs, const char* path)
-{
-    Serial.printf("Deleting file: %s\n", path);
-    if (fs.remove(path))
+    if(op < OP_FADE || op > OP_BENCH)
     {
-        Serial.println("File deleted");
+        return ST_BAD_OP;
     }
-    else
+    if(op == OP_BRIGHT && arg > 255)
     {
-        Serial.println("Delete failed");
+        serialOut.println("Maximum Value 255...");
+        arg = 255;
     }
-}
 
-void testFileIO(fs::FS &fs, const char* path)
-{
-    File file = fs.open(path);
-    static uint8_t buf[512];
-    size_t len = 0;
-    uint32_t start = millis();
-    uint32_t end = start;
-    if (file)
+    trace.handed = LatencyStats::now();
+    if(op == OP_FADE || op == OP_DELAY || op == OP_PATTERN || op == OP_BRIGHT || op == OP_XFADE) // Parameters: overwrite, render loop picks it up next frame
     {
-        len = file.size();
-        size_t flen = len;
-        start = millis();
-        while (len)
+        ledParams.update([op, arg, &trace](LedParams &params)
         {
-            size_t toRead = len;
-            if (toRead > 512)
+            params.trace = trace;
+            if(op == OP_FADE)
+            {
+                params.fade = arg;
+            }
+            else if(op == OP_DELAY)
+            {
+                params.delayMs = arg;
+            }
+            else if(op == OP_PATTERN)
             {
-                toRead = 512;
+                params.pattern = arg;
             }
-            file.read(buf, toRead);
-            len -= toRead;
+            else if(op == OP_XFADE)
+            {
+                params.xfadeMs = arg;
+            }
+            else
+            {
+                params.bright = arg;
+            }
+        });
+        notifyLedTask();
+
+        if(op == OP_FADE)
+        {
+            serialOut.printf("New Fade Value: %d\n\n", arg);
         }
-        end = millis() - start;
-        Serial.printf("%u bytes read for %u ms\n", flen, end);
-        file.close();
+        else if(op == OP_DELAY)
+        {
+            serialOut.printf("New Delay Value: %dms\n\n", arg);
+        }
+        else if(op == OP_PATTERN && arg >= 1 && arg <= NUM_PATTERNS)            // Invalid patterns turn the lights off instead
+        {
+            serialOut.printf("New Pattern: %d\n\n", arg);
+        }
+        else if(op == OP_BRIGHT)
+        {
+            serialOut.printf("New Brightness: %d / 255\n\n", arg);
+        }
+        else if(op == OP_XFADE)
+        {
+            serialOut.printf("New Crossfade Time: %dms\n\n", arg);
+        }
+        return ST_OK;
     }
-    else
+
+    someCmd.op = op;
+    someCmd.amount = arg;                                                       // copy input to Command node
+    someCmd.trace = trace;
+    if(xQueueSend(ledQueue, (void *)&someCmd, wait) != pdTRUE)                  // Send to ledQueue for interpretation
     {
-        Serial.println("Failed to open file for reading");
+        return ST_BUSY;
     }
+    notifyLedTask();
+    return ST_OK;
+}
 
-    file = fs.open(path, FILE_WRITE);
-    if (!file)
+void binaryFrameRX(const BinProtocol::Frame &request)                           // Handle 1 request frame & send its response
+{
+    BinProtocol::Frame response;
+    Message sendMsg;
+    uint8_t encoded[BinProtocol::MAX_ENCODED];
+    LatencyTrace trace = { LatencyStats::now(), LatencyStats::now(), 0 };       // Frame complete = received & parsed
+
+    response.seq = request.seq;                                                 // Host matches responses by `seq`
+    response.code = ST_OK;
+    response.len = 0;
+
+    if(request.code == OP_PING || request.code == OP_TEXTMODE)
     {
-        Serial.println("Failed to open file for writing");
-        return;
+        // nothing to do: mode change happens after the response is queued
+    }
+    else if(request.code == OP_TEXT)
+    {
+        memcpy(sendMsg.msg, request.payload, request.len);                      // Same path as a typed line
+        sendMsg.msg[min((int)request.len, (int)sizeof(sendMsg.msg) - 2)] = '\n';
+        sendMsg.msg[min((int)request.len + 1, (int)sizeof(sendMsg.msg) - 1)] = '\0';
+        sendMsg.stamp = trace.rx;
+        if(xQueueSend(msgQueue, (void *)&sendMsg, 0) != pdTRUE)
+        {
+            response.code = ST_BUSY;
+        }
+    }
+    else if(request.code == OP_FREQ)
+    {
+        int32_t freqs[3] = { (int32_t)getCpuFrequencyMhz(), (int32_t)getXtalFrequencyMhz(), (int32_t)(getApbFrequency() / 1000000) };
+        memcpy(response.payload, freqs, sizeof(freqs));
+        response.len = sizeof(freqs);
+    }
+    else
+    {
+        response.code = dispatchCommand(request.code, BinProtocol::argValue(request), 0, trace); // Never wait: keep the pipeline moving
     }
 
-    size_t i;
-    start = millis();
-    for (i = 0; i < 2048; i++)
+    serialOut.writeWait((const char *)encoded, BinProtocol::buildFrame(response, encoded)); // Responses are never dropped
+
+    if(request.code == OP_TEXTMODE)
     {
-        file.write(buf, 512);
+        binaryMode = false;
+        serialOut.setMuted(false);
+        serialOut.println("\nText Mode");
     }
-    end = millis() - start;
-    Serial.printf("%u bytes written for %u ms\n", 2048 * 512, end);
-    file.close();
 }
 
-/*************************************************************************************************************************/
-
 /*** User CLI Start ***/                                                        /** Creates A Node dropped into The msgQueue ***/
 
+void binModeCommand(const char *args)                                           // `binmode`: switch before the next byte arrives
+{
+    serialOut.println("Binary Mode: send COBS frames, opcode 0x21 returns to text");
+    serialOut.setMuted(true);                                                   // Text would only waste link bandwidth
+    binaryMode = true;
+}
+
+void forwardLine(const char *line)                                              // Every other line is parsed by `msgRXTask`
+{
+    Message sendMsg;
+    snprintf(sendMsg.msg, sizeof(sendMsg.msg), "%s", line);                     // copy input to Message node
+    sendMsg.stamp = rxStamp;
+    xQueueSend(msgQueue, (void *)&sendMsg, 10);                                 // Send to msgQueue for interpretation
+}
+
 void userCLITask(void *param)                                                   // Function definition for user CLI task
 {
-    Message sendMsg;                                                            // Declare user message
-    char input;                                                                 // Each char of user input                                             
-    char buffer[BUF_LEN];                                                       // buffer to hold user input
-    uint8_t index = 0;                                                          // character count
+    BinProtocol::FrameReader frameReader;                                       // Assembles binary frames in `binmode`
+    BinProtocol::Frame frame;
+    char input;                                                                 // Each char of user input
 
-    memset(buffer, 0, BUF_LEN);                                                 // Clear user input buffer
+    cli.add(binModeCmd, binModeCommand);
+    cli.setDefault(forwardLine);
+    cli.begin(Serial, serialOut);                                               // Echo goes through the TX ring
+    QueueHandle_t queue;
 
     for(;;)
     {       
-        if(Serial.available() > 0)
+        rxStamp = LatencyStats::now();                                          // Keystroke stamp for every line in this batch
+        while(Serial.available() > 0)                                           // Drain everything received since last time
         {
             input = Serial.read();                                              // read each character of user input
 
-            if(index < (BUF_LEN - 1))
-            {
-                buffer[index] = input;                                          // write received character to buffer
-                index++;
-            }
-            if(input == '\n')                                                   // Check when user presses ENTER key
+            if(binaryMode)
             {
-                Serial.print("\n");
-                strcpy(sendMsg.msg, buffer);                                    // copy input to Message node
-                xQueueSend(msgQueue, (void *)&sendMsg, 10);                     // Send to msgQueue for interpretation
-                memset(buffer, 0, BUF_LEN);                                     // Clear input buffer
-                index = 0;                                                      // Reset index counter.
+                if(frameReader.push((uint8_t)input, frame) > 0)                 // Bad frames are dropped: host sees no response
+                {
+                    binaryFrameRX(frame);
+                }
             }
-            else // echo each character back to the serial terminal
+            else
             {
-                Serial.print(input);
+                cli.feed(input);
             }
         }
-        vTaskDelay(25 / portTICK_PERIOD_MS);                                    // yield to other tasks
+        if(cliEvents.wait(queue) == cliEvents.EV_SHUTDOWN)                      // Sleep until more bytes arrive (text or binary)
+        {
+            break;
+        }
+    }
+    vTaskDelete(NULL);
+}
+
+void printSDResult(const SDRequest &request, const SDResult &result)            // `done` callback: runs on `SDCardTask`
+{
+    serialOut.printf("%s %s: %s", SDService::opName(request.op), request.path, SDService::statusName(result.status));
+    if(result.bytes > 0)
+    {
+        serialOut.printf(", %u bytes", result.bytes);
+    }
+    serialOut.printf(" (%uus queued, %uus on card)\n\n", result.waitUs, result.runUs);
+}
+
+void queueSDRequest(uint8_t op, char *tailPtr, LatencyTrace trace)              // Parse `<path> [text|path]` & hand it to `SDCardTask`
+{
+    SDRequest request = {};
+    request.op = op;
+    request.done = printSDResult;
+    request.trace = trace;
+
+    tailPtr[strcspn(tailPtr, "\r\n")] = '\0';
+    tailPtr += strspn(tailPtr, " ");
+    int pathLen = strcspn(tailPtr, " ");
+    char *argPtr = tailPtr + pathLen;
+    argPtr += strspn(argPtr, " ");
+
+    bool fixedPath = (op == SD_OP_BENCH || op == SD_OP_LOG || op == SD_OP_LOGSYNC || op == SD_OP_LOGCAT ||
+                      op == SD_OP_USAGE);
+
+    if((pathLen == 0 && op != SD_OP_LSDIR && !fixedPath) || (op == SD_OP_RENAME && *argPtr == '\0') ||
+       (op == SD_OP_LOG && *tailPtr == '\0'))
+    {
+        serialOut.printf("Missing Argument For %s: Enter 'lscmd' For Usage\n", SDService::opName(op));
+        return;
+    }
+    if(op == SD_OP_LOG)                                                         // The whole rest of the line is the text
+    {
+        snprintf(request.path, sizeof(request.path), "%s", CliLogDir);
+        snprintf(request.arg, sizeof(request.arg), "%s\n", tailPtr);
+    }
+    else if(fixedPath)                                                          // The only argument is a size (or `fat`): no path
+    {
+        snprintf(request.path, sizeof(request.path), "%s", (op == SD_OP_BENCH) ? "/bench" : CliLogDir);
+        snprintf(request.arg, sizeof(request.arg), "%.*s", pathLen, tailPtr);
+    }
+    else
+    {
+        snprintf(request.path, sizeof(request.path), "%s%.*s", (tailPtr[0] == '/') ? "" : "/", pathLen, tailPtr);
+    }
+    if(op == SD_OP_RENAME)
+    {
+        snprintf(request.arg, sizeof(request.arg), "%s%.*s", (argPtr[0] == '/') ? "" : "/", (int)strcspn(argPtr, " "), argPtr);
+    }
+    else if(op == SD_OP_WRITE || op == SD_OP_APPEND)                           // Text is 1 line: keep its line break in the file
+    {
+        snprintf(request.arg, sizeof(request.arg), "%s\n", argPtr);
+    }
+    else if(op == SD_OP_READ)                                                   // Range: `head N`, `tail N` or `<offset> [bytes]`
+    {
+        snprintf(request.arg, sizeof(request.arg), "%s", argPtr);
+    }
+
+    if(!sdService.submit(request, 0))                                           // Never wait here: a slow card must not stall the CLI
+    {
+        serialOut.println("SD Queue Full: Try Again");
     }
 }
 
 void msgRXTask(void *param) /*** CLI Input Validation / Handling ***/           /*** Analyze Each Node **/
 {
     Message someMsg;                                                            // Each object given from the user
-    Command someCmd;
-    SDCommand sdCardCmd;                                                        // New object for SD Card Comms
-    uint8_t localCPUFreq;                                                       // 80, 160 or 240Mhz
-    char buffer[BUF_LEN];                                                       // string buffer for Terminal Message
-    short ledDelay;                                                             // blink delay in ms
-    short fadeAmt;
-    short pattern;
-    short bright;
 
-    memset(buffer, 0, BUF_LEN);                                                 // Clear input buffer
+    QueueHandle_t queue;
 
     for(;;)
     {
-        if(xQueueReceive(msgQueue, (void *)&someMsg, 0) == pdTRUE)              // If a `Message` is rec'd from queue
+        WaitSet<1>::Event event = msgEvents.wait(queue);                        // Sleep until a line arrives: no polling delay
+        if(event == msgEvents.EV_SHUTDOWN)
+        {
+            break;
+        }
+        if(event == msgEvents.EV_QUEUE && xQueueReceive(queue, (void *)&someMsg, 0) == pdTRUE)
         {   
-            /* LED Commands */
+            LatencyTrace trace = { someMsg.stamp, LatencyStats::now(), 0 };
+            /* LED Commands */                                                  // Parsed into the same opcodes as `binmode` frames
             if(memcmp(someMsg.msg, fadeCmd, 5) == 0)                            // Check for `fade ` command: Ref: https://cplusplus.com/reference/cstring/memcmp/
             {
-                char* tailPtr = someMsg.msg + 5;                                // pointer arithmetic: move pointer to integer value
-                fadeAmt = atoi(tailPtr);                                        // retreive integer value at end of string
-                fadeAmt = abs(fadeAmt);                                         // fadeAmt can't be negative
-                if(fadeAmt <= 0 || fadeAmt > 128)
-                {
-                    Serial.println("Value Must Be Between 1 & 128");
-                    Serial.println("Returning....");
-                    continue;
-                }
-                strcpy(someCmd.cmd, "fade");
-                someCmd.amount = fadeAmt;                                       // copy input to Command node
-                xQueueSend(ledQueue, (void *)&someCmd, 10);                     // Send to ledQueue for interpretation
+                dispatchCommand(OP_FADE, atoi(someMsg.msg + 5), 10, trace);     // pointer arithmetic: integer value after command
             }
             else if(memcmp(someMsg.msg, delayCmd, 6) == 0)                      // Check for `delay ` command
             {
-                char* tailPtr = someMsg.msg + 6;                                // pointer arithmetic: move pointer to integer value
-                ledDelay = atoi(tailPtr);                                       // retreive integer value at end of string
-                ledDelay = abs(ledDelay);                                       // ledDelay can't be negative
-                if(ledDelay <= 0)
-                {
-                    Serial.println("Value Must Be > 0");
-                    Serial.println("Returning....");
-                    continue;
-                }
-                strcpy(someCmd.cmd, "delay");
-                someCmd.amount = ledDelay;                                      // copy input to Command node
-                xQueueSend(ledQueue, (void *)&someCmd, 10);                     // Send to ledQueue for interpretation                    // Clear input buffer
+                dispatchCommand(OP_DELAY, atoi(someMsg.msg + 6), 10, trace);
             }
             else if(memcmp(someMsg.msg, patternCmd, 8) == 0)                    // Check for `pattern ` command
             {
-                char* tailPtr = someMsg.msg + 8;                                // pointer arithmetic: move pointer to integer value
-                pattern = atoi(tailPtr);                                        // retreive integer value at end of string
-                pattern = abs(pattern);                                         // patternType can't be negative
-
-                strcpy(someCmd.cmd, "pattern");
-                someCmd.amount = pattern;                                       // copy input to Command node
-                xQueueSend(ledQueue, (void *)&someCmd, 10);                     // Send to ledQueue for interpretation
+                dispatchCommand(OP_PATTERN, atoi(someMsg.msg + 8), 10, trace);
             }
             else if(memcmp(someMsg.msg, brightCmd, 7) == 0)                     // Check for `bright ` command
             {
-                char* tailPtr = someMsg.msg + 7;                                // pointer arithmetic: move pointer to integer value
-                bright = atoi(tailPtr);                                         // retreive integer value at end of string
-                bright = abs(bright);                                           // ledDelay can't be negative
-                
-                strcpy(someCmd.cmd, "bright");
-                someCmd.amount = bright;                                        // copy input to Command node
-                xQueueSend(ledQueue, (void *)&someCmd, 10);                     // Send to ledQueue for interpretation
+                dispatchCommand(OP_BRIGHT, atoi(someMsg.msg + 7), 10, trace);
             }
             else if(memcmp(someMsg.msg, cpuCmd, 4) == 0)                        // check for `cpu ` command
             {
-                char* tailPtr = someMsg.msg + 4;
-                localCPUFreq = atoi(tailPtr);
-                localCPUFreq = abs(localCPUFreq);
-
-                strcpy(someCmd.cmd, "cpu");
-                someCmd.amount = localCPUFreq;                                  // copy input to Message node
-                xQueueSend(ledQueue, (void *)&someCmd, 10);                     // Send to ledQueue for interpretation
+                dispatchCommand(OP_CPU, atoi(someMsg.msg + 4), 10, trace);
             }
             else if(memcmp(someMsg.msg, getValues, 6) == 0)
             {
-                strcpy(someCmd.cmd, "values");
-                someCmd.amount = 0;                                             // copy input to Message node
-                xQueueSend(ledQueue, (void *)&someCmd, 10);                     // Send to ledQueue for interpretation
+                dispatchCommand(OP_VALUES, 0, 10, trace);
             }
             else if(memcmp(someMsg.msg, getFreq, 4) == 0)
             {
-                strcpy(someCmd.cmd, "freq");
-                someCmd.amount = 0;                                             // copy input to Message node
-                xQueueSend(ledQueue, (void *)&someCmd, 10);                     // Send to ledQueue for interpretation
+                dispatchCommand(OP_FREQ, 0, 10, trace);
+            }
+            else if(memcmp(someMsg.msg, xfadeCmd, 6) == 0)                      // Check for `xfade ` command
+            {
+                dispatchCommand(OP_XFADE, atoi(someMsg.msg + 6), 10, trace);
+            }
+            else if(memcmp(someMsg.msg, benchCmd, 5) == 0)                      // `bench` alone = 300 LEDs
+            {
+                dispatchCommand(OP_BENCH, atoi(someMsg.msg + 5), 10, trace);
+            }
+            else if(memcmp(someMsg.msg, perfCmd, 4) == 0)                       // `perf` / `perf reset`: handled right here
+            {
+                if(strstr(someMsg.msg + 4, "reset") != NULL)
+                {
+                    latency.reset();
+                    sdLatency.reset();
+                    serialOut.println("Latency Histograms Cleared\n");
+                }
+                else
+                {
+                    latency.report(serialOut);
+                    sdLatency.report(serialOut, "SD Request Latency");
+                }
             }
             
-            /*** SD Card Commands ***/                                          /* Start with 'List all commands' command */
-            
-            else if(memcmp(someMsg.msg, sdListCmds, 5) == 0)                    // if `lscmd` command rec'd (compare to global var)
-            {   
-                // send sdCardCmd over the sdQueue to perform an operation on the SD Card
-                strcpy(sdCardCmd.cmd, "lscmd");                                 // pass "lscmd" on to the SD card queue? Handle this over there instead.
-                strcpy(sdCardCmd.msg, "");                                      // send an empty string? maybe just call a txt that lists what the commands are?
-                xQueueSend(sdQueue, (void *)&someCmd, 10);                      // send `lscmd` to `sdQueue` ... wait 10ms if busy
+            /*** Script Commands ***/
+
+            else if(memcmp(someMsg.msg, runCmd, 4) == 0)                        // if `run ` command rec'd
+            {
+                if(xQueueSend(scriptQueue, (void *)&someMsg, 10) != pdTRUE)     // `scriptTask` parses the path
+                {
+                    serialOut.println("Script Queue Full: Try Again");
+                }
+            }
+            else if(memcmp(someMsg.msg, stopCmd, 4) == 0)                       // if `stop` command rec'd
+            {
+                scriptAbort = true;
+                playAbort = true;
+                if(scriptRunner != NULL)
+                {
+                    xTaskNotifyGive(scriptRunner);                              // Wake it if it sits in a `wait`
+                }
             }
-            else if(memcmp(someMsg.msg, sdListDir, 6) == 0)                     // if `lsdir ` command rec'd (compare to global var)
+            else if(memcmp(someMsg.msg, playCmd, 5) == 0)                       // if `play ` command rec'd
             {
-                // send sdCardCmd over the sdQueue to perform an operation on the SD Card
-                strcpy(sdCardCmd.cmd, "lsdir");                                 // pass "lsdir" on to the SD card queue...Handle this over there instead.
-                strcpy(sdCardCmd.msg, "");                                      // send empty string (no message)
-                xQueueSend(sdQueue, (void *)&someCmd, 10);                      // send `lscmd` to `sdQueue`
-                // memset(buffer, 0, BUF_LEN);  
+                playAbort = true;                                               // A new file replaces the one playing
+                if(xQueueSend(playQueue, (void *)&someMsg, 10) != pdTRUE)       // `playTask` parses the path
+                {
+                    serialOut.println("Play Queue Full: Try Again");
+                }
             }
-            else if(memcmp(someMsg.msg, sdCreateDir, 6) == 0)                   // if `mkdir ` command rec'd (compare to global var)
+            else if(memcmp(someMsg.msg, atCmd, 3) == 0 || memcmp(someMsg.msg, everyCmd, 6) == 0 ||
+                    memcmp(someMsg.msg, cancelCmd, 7) == 0 || memcmp(someMsg.msg, jobsCmd, 4) == 0)
             {
+                if(xQueueSend(schedQueue, (void *)&someMsg, 10) != pdTRUE)      // `schedulerTask` owns the timer queue
+                {
+                    serialOut.println("Scheduler Queue Full: Try Again");
+                }
+            }
+
+            /*** SD Card Commands ***/                                          // Queued for `SDCardTask`: the CLI never waits for the card
 
-                // need to pass to the SD Queue...
-                // each element rec'd, handle in the proper queue...
-                // Found a Command to create dir...
-                // FW to sdCardQueue....handle it over there...
+            else if(memcmp(someMsg.msg, sdListCmds, 5) == 0)                    // if `lscmd` command rec'd: no card access, handled right here
+            {
+                serialOut.print("\nSD Commands (results print when the card is done):\n");
+                serialOut.print("  lsdir [dir], mkdir <dir>, rmdir <dir>, lsbytes [fat]\n");
+                serialOut.print("  readfile <file> [head N | tail N | <offset> [bytes]]\n");
+                serialOut.print("  writefile <file> <text>, append <file> <text>\n");
+                serialOut.print("  rename <from> <to>, rmfile <file>\n");
+                serialOut.print("  sdbench [kB]: MB/s & latency per block size, CSV in /bench/sdbench.csv\n");
+                serialOut.print("  log <text>, logsync, logcat [kB]: 8 x 128kB rotating log in /log (synced every 1s)\n\n");
+            }
+            else if(memcmp(someMsg.msg, sdListDir, 5) == 0)                     // if `lsdir` command rec'd (compare to global var)
+            {
+                queueSDRequest(SD_OP_LSDIR, someMsg.msg + 5, trace);
+            }
+            else if(memcmp(someMsg.msg, sdCreateDir, 6) == 0)                   // if `mkdir ` command rec'd (compare to global var)
+            {
+                queueSDRequest(SD_OP_MKDIR, someMsg.msg + 6, trace);
             }
             else if(memcmp(someMsg.msg, sdDeleteDir, 6) == 0)                   // if `rmdir ` command rec'd (compare to global var)
             {
-                // need a directory for a choice...parse string again....
-                // memset(buffer, 0, BUF_LEN);
+                queueSDRequest(SD_OP_RMDIR, someMsg.msg + 6, trace);
             }
             else if(memcmp(someMsg.msg, sdReadFile, 9) == 0)                    // if `readfile ` command rec'd (compare to global var)
             {
-
-            }       
+                queueSDRequest(SD_OP_READ, someMsg.msg + 9, trace);
+            }
             else if(memcmp(someMsg.msg, sdWriteFile, 10) == 0)                  // if `writefile ` command rec'd
             {
-                // memset(buffer, 0, BUF_LEN);
+                queueSDRequest(SD_OP_WRITE, someMsg.msg + 10, trace);
             }
             else if(memcmp(someMsg.msg, sdAppendFile, 7) == 0)                  // if `append ` command rec'd
             {
-                // memset(buffer, 0, BUF_LEN);
+                queueSDRequest(SD_OP_APPEND, someMsg.msg + 7, trace);
             }
             else if(memcmp(someMsg.msg, sdRenameFile, 7) == 0)                  // if `rename ` command rec'd
             {
-
+                queueSDRequest(SD_OP_RENAME, someMsg.msg + 7, trace);
             }
             else if(memcmp(someMsg.msg, sdDeleteFile, 7) == 0)                  // if `rmfile ` command rec'd
             {
-
+                queueSDRequest(SD_OP_REMOVE, someMsg.msg + 7, trace);
             }
-            else if(memcmp(someMsg.msg, sdUsedSpace, 7) == 0)                   // if `lsbytes` command rec'd
+            else if(memcmp(someMsg.msg, sdUsedSpace, 7) == 0)                   // if `lsbytes` command rec'd: `lsbytes fat` also walks the FAT
             {
-            
+                queueSDRequest(SD_OP_USAGE, someMsg.msg + 7, trace);
+            }
+            else if(memcmp(someMsg.msg, sdBenchCmd, 7) == 0)                    // if `sdbench` command rec'd: `sdbench` alone = 1MB file
+            {
+                queueSDRequest(SD_OP_BENCH, someMsg.msg + 7, trace);
+            }
+            else if(memcmp(someMsg.msg, logCmd, 4) == 0)                        // if `log ` command rec'd
+            {
+                queueSDRequest(SD_OP_LOG, someMsg.msg + 4, trace);
+            }
+            else if(memcmp(someMsg.msg, logSyncCmd, 7) == 0)                    // if `logsync` command rec'd
+            {
+                queueSDRequest(SD_OP_LOGSYNC, someMsg.msg + 7, trace);
+            }
+            else if(memcmp(someMsg.msg, logCatCmd, 6) == 0)                     // if `logcat` command rec'd
+            {
+                queueSDRequest(SD_OP_LOGCAT, someMsg.msg + 6, trace);
             }
             else // Not a command: Print the message to the terminal
             {
-                sprintf(buffer, "Invalid Command: %s\n", someMsg.msg);          // print user message
-                Serial.print(buffer);
-                memset(buffer, 0, BUF_LEN);                                     // Clear input buffer
+                serialOut.printf("Invalid Command: %s\n", someMsg.msg);         // print user message
             }
         }
-        vTaskDelay(20 / portTICK_PERIOD_MS);                                    // Yield to other tasks
     }
+    vTaskDelete(NULL);
+}
+
+void blendBenchmark(int leds)                                                   // `bench`: cost of 1 crossfade frame per LED
+{
+    const int runs = 100;
+    CRGB *from = (CRGB *)pvPortMalloc(leds * sizeof(CRGB));                     // Only for the run: no RAM kept for `bench`
+    CRGB *to = (CRGB *)pvPortMalloc(leds * sizeof(CRGB));
+    CRGB *out = (CRGB *)pvPortMalloc(leds * sizeof(CRGB));
+    if(from == NULL || to == NULL || out == NULL)
+    {
+        serialOut.println("Not Enough Heap For Benchmark\n");
+    }
+    else
+    {
+        for(int i = 0; i < leds; i++)                                           // Any content: the kernel has no branches
+        {
+            from[i] = CRGB(i, i * 3, i * 7);
+            to[i] = CRGB(i * 5, i * 11, i * 13);
+        }
+
+        uint32_t start = ESP.getCycleCount();
+        for(int run = 0; run < runs; run++)
+        {
+            blendFrames(out, from, to, leds, (uint8_t)(255 - run), (uint8_t)run);
+        }
+        uint32_t cycles = ESP.getCycleCount() - start;
+
+        uint32_t nsPerLed = (uint32_t)((uint64_t)cycles * 1000 / getCpuFrequencyMhz() / runs / leds);
+        uint32_t usPerFrame = nsPerLed * leds / 1000;
+        serialOut.printf("\nBlend: %d LEDs x %d Frames @ %dMHz\n", leds, runs, getCpuFrequencyMhz());
+        serialOut.printf("%u cycles / LED, %uns / LED, %uus / frame (%u%% of %ums frame)\n\n",
+                         cycles / runs / leds, nsPerLed, usPerFrame, usPerFrame / (FrameMs * 10), FrameMs);
+    }
+    vPortFree(from);
+    vPortFree(to);
+    vPortFree(out);
 }
 
-/* TODO: This program should decide which queue gets which struct (Commmand, SDCommand, or Message). Currently that is not the case.***/
-// only decide which queue to send each object.
 void RGBcolorWheelTask(void *param)
 {
     Command someCmd;                                                            // Received from `msgRXTask`
-    uint8_t localCPUFreq;
-    char buffer[BUF_LEN];
-     
-    int fadeInterval = 5;                                                       // LED fade interval
-    int delayInterval = 30;                                                     // Delay between changing fade intervals
-    int patternType = 1;                                                        // default LED pattern: case 1
-    int brightVal = 250;                                                        // Brightness Command (Pattern 3) initial value
-    int brightness = 65;                                                        // Initial Brightness value
-
-    short hueVal = 0;                                                           // add 32 each time for each color...
-    bool swap = false;                                                          // Swap Red/Blue colors
-    bool lightsOff = false;
-    uint8_t accessLEDCAnalog = 1;
-    leds[0] = CRGB::Red;
-    FastLED.show();
+    LedParams params;                                                           // Snapshot of `ledParams`, taken once per frame at most
+    uint32_t paramVersion = ledParams.read(params);
+    uint32_t paramPicked = 0;                                                   // Cycle count of the snapshot, 0 = nothing to record
+
+    LedOutput output(strip, LEDCchan, LEDCtimer);
+    Crossfade crossfade(fadeFrom, fadeTo);
+    LedPattern *pattern = &patternFor(params.pattern);                          // Registry lookup: pattern # is the index
+    int32_t patternType = params.pattern;
+    pattern->setParams(PatternParams{ params.fade, params.delayMs, params.bright });
+    pattern->init(output);
+
+    uint32_t frame = 0;
+    uint32_t wakeups = 0;                                                       // Frames + idle wakeups
+    uint32_t renderUs = 0;                                                      // Last `render()` call
+    uint64_t renderUsTotal = 0;
+    TickType_t lastWake = xTaskGetTickCount();
+    int64_t lastFrameUs = esp_timer_get_time();                                 // Monotonic us: unaffected by `cpu` changes
 
     for(;;)
     {
-        /*** Command Handling ***/
-        if(xQueueReceive(ledQueue, (void *)&someCmd, 0) == pdTRUE)              // if command received from MSG QUEUE
+        wakeups++;
+
+        /*** Parameter Handling ***/
+        if(ledParams.version() != paramVersion)                                 // Any # of writes since last frame = 1 snapshot
         {
-            if(memcmp(someCmd.cmd, fadeCmd, 4) == 0)                            // if `fade` command rec'd (compare to global var)
+            paramVersion = ledParams.read(params);
+            paramPicked = LatencyStats::now();
+            if(params.pattern != patternType)                                   // O(1) switch: no per-frame pattern chain
             {
-                fadeInterval = someCmd.amount;
-                sprintf(buffer, "New Fade Value: %d\n\n", someCmd.amount);      // BUGFIX: sometimes displays negative number
-                Serial.print(buffer);                
-                memset(buffer, 0, BUF_LEN); 
+                LedPattern *previous = pattern;
+                patternType = params.pattern;
+                pattern = &patternFor(patternType);
+                pattern->setParams(PatternParams{ params.fade, params.delayMs, params.bright });
+                crossfade.start(output, *previous, *pattern, params.xfadeMs);   // Calls `init()`: now or captured for the blend
+                if(patternType < 1 || patternType > NUM_PATTERNS)
+                {
+                    serialOut.println("Invalid Pattern...Turning Lights Off!!\n");
+                }
             }
-            else if(memcmp(someCmd.cmd, delayCmd, 5) == 0)                      // if `delay` command rec'd (compare to global var)
+            pattern->setParams(PatternParams{ params.fade, params.delayMs, params.bright });
+        }
+
+        /*** Command Handling ***/
+        while(xQueueReceive(ledQueue, (void *)&someCmd, 0) == pdTRUE)           // Drain: at most 1 frame of latency
+        {
+            uint32_t picked = LatencyStats::now();
+            if(someCmd.op == OP_CPU)                                            // if `cpu` command rec'd (validated in `dispatchCommand`)
             {
-                delayInterval = someCmd.amount;
-                sprintf(buffer, "New Delay Value: %dms\n\n", someCmd.amount);
-                Serial.print(buffer);
-                memset(buffer, 0, BUF_LEN);  
+                setCpuFrequencyMhz(someCmd.amount);                             // Set New CPU Freq
+                vTaskDelay(10 / portTICK_PERIOD_MS);                            // yield for a brief moment
+
+                serialOut.printf("\nNew CPU Frequency is: %dMHz\n\n", getCpuFrequencyMhz());
             }
-            else if((memcmp(someCmd.cmd, patternCmd, 6) == 0))                  // if `pattern` command rec'd (compare to global var)
+            else if(someCmd.op == OP_VALUES)                                    // if `values` command rec'd
             {
-                patternType = someCmd.amount;
-                if(int(abs(patternType)) <= NUM_PATTERNS && int(patternType) != 0) // BUGFIX: "New Pattern: 0" with invalid entry
-                {
-                    sprintf(buffer, "New Pattern: %d\n\n", someCmd.amount);
-                    Serial.print(buffer);
-                    memset(buffer, 0, BUF_LEN);
-                }
+                serialOut.printf("\nCurrent Delay = %dms.           (default = 30ms)\n", params.delayMs);
+                serialOut.printf("Current Fade Interval = %d.      (default = 5)\n", params.fade);
+                serialOut.printf("Current Pattern = %d.            (default = 1)\n", params.pattern);
+                serialOut.printf("Current Brightness = %d / 255. (default = 250)\n", params.bright);
+                serialOut.printf("Current Crossfade = %dms.        (default = 250ms)\n", params.xfadeMs);
+                serialOut.printf("Parameter Updates = %u\n", paramVersion);
+                serialOut.printf("Frames Rendered = %u @ %ums\n", frame, FrameMs);
+                serialOut.printf("Strip: %u LEDs, %u fps, %u Shown, %u Replaced Before Output\n",
+                                 (unsigned)strip.size(), strip.fps(), strip.shown(), strip.replaced());
+                serialOut.printf("Frames Emitted = %u / %u Rendered (%u Unchanged Skipped)\n",
+                                 strip.shown(), frame, strip.unchanged());
+                serialOut.printf("Blue LED Writes = %u (%u Unchanged Skipped)\n", output.blueWrites(), output.blueSkipped());
+                serialOut.printf("Render: %uus last, %uns / LED avg, Output: %uus / frame\n", renderUs,
+                                 frame ? (uint32_t)(renderUsTotal * 1000 / frame / NUM_LEDS) : 0, strip.showUs());
+                serialOut.printf("LED Task Wakeups = %u (%u Hardware Fades)\n", wakeups, output.blueFades());
+                serialOut.printf("Animation: %s, %u Frames Shown, %u Underruns\n", animation.playing() ? "Playing" : "Stopped",
+                                 animation.shown(), animation.underruns());
+                serialOut.printf("SD Requests = %u Done, %u Failed, %u Pending, %u Rejected (Queue Full), %uus Max\n",
+                                 sdService.completed(), sdService.failed(), sdService.pending(), sdService.rejected(),
+                                 sdService.maxRunUs());
+                serialOut.printf("CLI Log = %llu Bytes in %u / %u Segments (Current %u), %u Rotations, %u Lines, %u Syncs, %u Dropped\n",
+                                 cliLog.usedBytes(), cliLog.segmentsUsed(), cliLog.segments(), cliLog.currentSegment(),
+                                 cliLog.rotations(), cliLog.segmentLog().appends(), cliLog.segmentLog().syncs(),
+                                 cliLog.dropped() + cliLog.segmentLog().dropped());
+                serialOut.printf("Serial TX Dropped Writes = %u\n\n", serialOut.dropped());
             }
-            else if(memcmp(someCmd.cmd, brightCmd, 5) == 0)                     // if `bright` command rec'd (compare to global var)
+            else if(someCmd.op == OP_BENCH)                                     // if `bench` command rec'd
             {
-                brightVal = someCmd.amount;                
-                if(brightVal >= 255)
-                {
-                    Serial.println("Maximum Value 255...");
-                    brightVal = 255;
-                }               
-                sprintf(buffer, "New Brightness: %d / 255\n\n", someCmd.amount);
-                Serial.print(buffer);
-                memset(buffer, 0, BUF_LEN);
+                blendBenchmark(someCmd.amount > 0 ? someCmd.amount : 300);
             }
-            else if(memcmp(someCmd.cmd, cpuCmd, 3) == 0)                        // if `cpu` command rec'd (complare to global var)
+            else if(someCmd.op == OP_FREQ)                                      // if `freq` command rec'd
             {
-                localCPUFreq = someCmd.amount;
-                if(localCPUFreq != 240 && localCPUFreq != 160 && localCPUFreq != 80)
-                {
-                    Serial.println("Invalid Input: Must Be 240, 160, or 80Mhz");
-                    Serial.println("Returning....\n");
-                    continue;
-                }
-                setCpuFrequencyMhz(localCPUFreq);                               // Set New CPU Freq
-                vTaskDelay(10 / portTICK_PERIOD_MS);                            // yield for a brief moment
+                serialOut.printf("\nCPU Frequency is:  %d MHz", getCpuFrequencyMhz());
+                serialOut.printf("\nXTAL Frequency is: %d MHz", getXtalFrequencyMhz());
+                serialOut.printf("\nAPB Freqency is:   %d MHz\n\n", (getApbFrequency() / 1000000));
+            }
+            latency.record(someCmd.trace, picked, LatencyStats::now());         // Applied = output queued
+        }
 
-                sprintf(buffer, "\nNew CPU Frequency is: %dMHz\n\n", getCpuFrequencyMhz());
-                Serial.print(buffer);
-                memset(buffer, 0, BUF_LEN);
-            }
-            else if(memcmp(someCmd.cmd, getValues, 6) == 0)                     // if `values` command rec'd (complare to global var)
-            {
-                sprintf(buffer, "\nCurrent Delay = %dms.           (default = 30ms)\n", delayInterval);
-                Serial.print(buffer);
-                memset(buffer, 0, BUF_LEN);
-                sprintf(buffer, "Current Fade Interval = %d.      (default = 5)\n", abs(fadeInterval));
-                Serial.print(buffer);
-                memset(buffer, 0, BUF_LEN);
-                sprintf(buffer, "Current Pattern = %d.            (default = 1)\n", patternType);
-                Serial.print(buffer);
-                memset(buffer, 0, BUF_LEN);
-                sprintf(buffer, "Current Brightness = %d / 255. (default = 250)\n\n", brightVal);
-                Serial.print(buffer);
-                memset(buffer, 0, BUF_LEN);
-            }
-            else if(memcmp(someCmd.cmd, getFreq, 4) == 0)                       // if `freq` command rec'd (compare to global var)
-            {
-                sprintf(buffer, "\nCPU Frequency is:  %d MHz", getCpuFrequencyMhz());
-                Serial.print(buffer);
-                memset(buffer, 0, BUF_LEN);
-                sprintf(buffer, "\nXTAL Frequency is: %d MHz", getXtalFrequencyMhz());
-                Serial.print(buffer);
-                memset(buffer, 0, BUF_LEN); 
-                sprintf(buffer, "\nAPB Freqency is:   %d MHz\n\n", (getApbFrequency() / 1000000));
-                Serial.print(buffer);
-                memset(buffer, 0, BUF_LEN);
-            }
-            vTaskDelay(10 / portTICK_PERIOD_MS);                                // yield briefly (only if command rec'd)
-        }
-        else /*** Show LED Patterns ***/
-        {
-            if(patternType == 1)                                                // Fade On/Off & cycle through 8 colors
-            {
-                lightsOff = false;
-                if(accessLEDCAnalog == 1)
-                {
-                    ledcAnalogWrite(LEDCchan, 0);                               // Only Need to do this ONCE
-                    accessLEDCAnalog = 0;
-                }
-                brightness += fadeInterval;                                     // Adjust brightness by fadeInterval
-                if(brightness <= 0)                                             // Only change color if value <= 0
-                {
-                    brightness = 0;
-                    fadeInterval = -fadeInterval;                               // Reverse fade effect
-                    hueVal += 32;                                               // Change color
-                    if(hueVal >= 255)
-                    {
-                        hueVal = 0;                         
-                    }
-                    leds[0] = CHSV(hueVal, 255, 255);                           // Rotate: Rd-Orng-Yel-Grn-Aqua-Blu-Purp-Pnk
-                }
-                else if(brightness >= 255)
-                {
-                    brightness = 255;
-                    fadeInterval = -fadeInterval;                               // Reverse fade effect
-                }
-                FastLED.setBrightness(brightness);
-                FastLED.show();
+        /*** Render 1 Frame ***/
+        int64_t nowUs = esp_timer_get_time();
+        if(crossfade.active())
+        {
+            crossfade.render(output, frame++, (uint32_t)(nowUs - lastFrameUs)); // Both patterns, blended
+        }
+        else
+        {
+            pattern->render(output, frame++, (uint32_t)(nowUs - lastFrameUs));  // Real elapsed time: late frames move further
+        }
+        lastFrameUs = nowUs;
+        renderUs = (uint32_t)(esp_timer_get_time() - nowUs);                    // Drawing only: output runs in its own task
+        renderUsTotal += renderUs;
+
+        if(paramPicked != 0)                                                    // 1st frame rendered with the new parameters
+        {
+            latency.record(params.trace, paramPicked, LatencyStats::now());
+            paramPicked = 0;
+        }
+
+        uint32_t idleMs = crossfade.active() ? LedPattern::IDLE_NONE : pattern->idleMs();
+        if(idleMs == LedPattern::IDLE_NONE)
+        {
+            vTaskDelayUntil(&lastWake, FrameMs / portTICK_PERIOD_MS);           // Fixed frame rate: `delay` only sets the step time
+        }
+        else                                                                    // Nothing moves: sleep until a command, fade end or timeout
+        {
+            ulTaskNotifyTake(pdTRUE, (idleMs == LedPattern::IDLE_FOREVER) ? portMAX_DELAY : pdMS_TO_TICKS(max(idleMs, FrameMs)));
+            lastWake = xTaskGetTickCount();
+        }
+    }
+}
+
+uint8_t sdBenchmark(fs::FS &fs, const char *dir, uint32_t kB, uint32_t &bytes)  // `sdbench`: ~20s for the default 1MB
+{
+    static SDBench bench(fs, dir);                                              // ~1kB of results: keep them off the task stack
+    uint8_t *buffer = (uint8_t *)pvPortMalloc(SDBench::MAX_BLOCK);              // Only for the run: no RAM kept for `sdbench`
+    if(buffer == NULL)
+    {
+        serialOut.println("Not Enough Heap For SD Benchmark\n");
+        return SD_ST_FAILED;
+    }
+    kB = (kB == 0) ? 1024 : min(kB, SDBenchMaxKB);
+    bool ok = bench.run(kB * 1024, buffer, serialOut);
+    vPortFree(buffer);
+    for(size_t i = 0; i < bench.size(); i++)
+    {
+        bytes += (uint32_t)bench.row(i).bytes;
+    }
+    return ok ? SD_ST_OK : SD_ST_FAILED;
+}
+
+bool openCliLog(const char *dir)                                                // Later boots reopen the segment the index points at
+{
+    return cliLog.isOpen() || cliLog.open(SD, dir, CliLogSegments, CliLogSegmentBytes, CliLogSyncMs);
+}
+
+uint8_t logLine(const SDRequest &request, uint32_t &bytes)                     // `log`: usually only a copy into RAM
+{
+    char line[sizeof(request.arg) + 12];
+    int len = snprintf(line, sizeof(line), "%u %s", (uint32_t)(request.queuedUs / 1000), request.arg); // ms since boot, when typed
+    if(!openCliLog(request.path))
+    {
+        return SD_ST_NOT_FOUND;
+    }
+    if(!cliLog.append(line, len))
+    {
+        return SD_ST_FAILED;                                                    // Card error: a full segment just rotates
+    }
+    bytes = len;
+    return SD_ST_OK;
+}
+
+uint8_t printLog(const char *dir, uint32_t kB, uint32_t &bytes)                 // `logcat`: the last `kB` synced to the card, oldest 1st
+{
+    if(!openCliLog(dir) || !cliLog.sync())
+    {
+        return SD_ST_NOT_FOUND;
+    }
+    uint32_t want = ((kB == 0) ? 4 : kB) * 1024;
+    uint32_t back = 0;
+    uint32_t total = cliLog.segmentLength(cliLog.currentSegment());
+    while(total < want && back + 1 < cliLog.segmentsUsed())                     // Lengths come from the index: no file opened yet
+    {
+        back++;
+        total += cliLog.segmentLength(cliLog.segmentBack(back));
+    }
+    uint32_t skip = (total > want) ? total - want : 0;                          // Only the oldest segment printed starts mid-way
+    serialOut.printf("Log %s: %llu bytes in %u segments, last %u:\n", dir, cliLog.usedBytes(), cliLog.segmentsUsed(),
+                     total - skip);
+
+    bytes = 0;
+    for(int32_t i = back; i >= 0; i--)
+    {
+        uint8_t segment = cliLog.segmentBack(i);
+        char path[48];
+        cliLog.segmentPath(segment, path, sizeof(path));
+        File file = SD.open(path);                                              // 2nd handle to the current segment, read only
+        if(!file)
+        {
+            return SD_ST_NOT_FOUND;
+        }
+        uint32_t length = cliLog.segmentLength(segment) - skip;
+        bytes += blockReader.stream(file, AppendLog<4096>::HEADER_SIZE + skip, length, 0, [](const char *data, size_t len)
+        {
+            serialOut.writeWait(data, len);
+        });
+        file.close();
+        skip = 0;
+    }
+    return SD_ST_OK;
+}
+
+uint8_t printUsage(bool walkFat)                                                // `lsbytes`: log usage from its index, FAT walk on request
+{
+    serialOut.printf("\n\nSD Card Size: %lluMB\n", SD.cardSize() / (1024 * 1024));
+    serialOut.printf("Total space: %lluMB\n", SD.totalBytes() / (1024 * 1024));
+    if(openCliLog(CliLogDir))
+    {
+        serialOut.printf("CLI log: %llukB used, %llukB on the card (%u x %ukB segments, max)\n", cliLog.usedBytes() / 1024,
+                         cliLog.footprintBytes() / 1024, cliLog.segments(), cliLog.segmentSize() / 1024);
+    }
+    if(walkFat)                                                                 // Reads the whole FAT: seconds on a big card
+    {
+        serialOut.printf("Used space: %lluMB\n", SD.usedBytes() / (1024 * 1024));
+    }
+    return SD_ST_OK;
+}
+
+uint8_t runSDRequest(const SDRequest &request, SDResult &result)                // Only `SDCardTask` touches the card
+{
+    if(request.op == SD_OP_MOUNT)
+    {
+        return SD_ST_OK;                                                        // Mounted before the op ran
+    }
+    else if(request.op == SD_OP_LSDIR)
+    {
+        return listDir(SD, request.path, 0);
+    }
+    else if(request.op == SD_OP_MKDIR)
+    {
+        return createDir(SD, request.path);
+    }
+    else if(request.op == SD_OP_RMDIR)
+    {
+        return removeDir(SD, request.path);
+    }
+    else if(request.op == SD_OP_READ)
+    {
+        return readFile(SD, request.path, request.arg, result.bytes);
+    }
+    else if(request.op == SD_OP_WRITE)
+    {
+        return writeFile(SD, request.path, request.arg, FILE_WRITE, result.bytes);
+    }
+    else if(request.op == SD_OP_APPEND)
+    {
+        return writeFile(SD, request.path, request.arg, FILE_APPEND, result.bytes);
+    }
+    else if(request.op == SD_OP_RENAME)
+    {
+        return renameFile(SD, request.path, request.arg);
+    }
+    else if(request.op == SD_OP_REMOVE)
+    {
+        return deleteFile(SD, request.path);
+    }
+    else if(request.op == SD_OP_BENCH)
+    {
+        return sdBenchmark(SD, request.path, strtoul(request.arg, NULL, 10), result.bytes);
+    }
+    else if(request.op == SD_OP_LOG)
+    {
+        return logLine(request, result.bytes);
+    }
+    else if(request.op == SD_OP_LOGSYNC)
+    {
+        return (openCliLog(request.path) && cliLog.sync()) ? SD_ST_OK : SD_ST_FAILED;
+    }
+    else if(request.op == SD_OP_LOGCAT)
+    {
+        return printLog(request.path, strtoul(request.arg, NULL, 10), result.bytes);
+    }
+    else if(request.op == SD_OP_USAGE)
+    {
+        return printUsage(strcmp(request.arg, "fat") == 0);
+    }
+    return SD_ST_BAD_ARG;
+}
+
+void SDCardTask(void *param) /*** Owns the SD card: runs `sdService` requests in order, 1 at a time ***/
+{
+    SDRequest request;
+    SDResult result;
+    bool mounted = false;
+
+    for(;;)
+    {
+        uint32_t syncMs = cliLog.msUntilSync();
+        if(!sdService.next(request, (syncMs == cliLog.NEVER) ? portMAX_DELAY : pdMS_TO_TICKS(syncMs))) // Sleep until a request or log sync
+        {
+            cliLog.poll();                                                      // Time flush: lines older than `CliLogSyncMs`
+            continue;
+        }
+        uint32_t picked = LatencyStats::now();
+        result = SDResult{};
+
+        if(!mounted)                                                            // 1st request, or no card last time
+        {
+            SPI.begin(SD_SCK, SD_MISO, SD_MOSI, SD_CS);                         // Source: https://github.com/espressif/arduino-esp32/issues/5967
+            mounted = SD.begin(SD_CS);
+        }
+        result.status = mounted ? runSDRequest(request, result) : (uint8_t)SD_ST_NO_CARD;
+
+        sdService.complete(request, result);                                    // Callback / notification with status & timing
+        sdLatency.record(request.trace, picked, LatencyStats::now());
+        cliLog.poll();                                                          // Back-to-back requests must not hold up a sync
+    }
+}
+
+bool skipRepeatBlock(ScriptReader &script, char *line, size_t maxLen, uint32_t &lineCount) // `repeat 0`: past the matching `end`
+{
+    uint8_t nested = 0;
+    while(script.readLine(line, maxLen))
+    {
+        char *text = line + strspn(line, " \t");
+        lineCount++;
+        if(memcmp(text, repeatDirective, 7) == 0)
+        {
+            nested++;
+        }
+        else if(memcmp(text, endDirective, 3) == 0)
+        {
+            if(nested == 0)
+            {
+                return true;
             }
-            else if(patternType == 2)                                           // Fade On/Off Red/Blue Police Pattern
+            nested--;
+        }
+    }
+    return false;                                                               // End of file: no matching `end`
+}
+
+void scriptTask(void *param) /*** Runs `run <file>` scripts line by line through `msgRXTask` ***/
+{
+    enum { MAX_DEPTH = 4 };                                                     // Nested `repeat` blocks
+
+    struct Loop
+    {
+        uint32_t start;                                                         // File offset of the 1st line in the block
+        int32_t remaining;                                                      // Passes left, including the current one
+    };
+
+    Message someMsg;
+    Message lineMsg;
+    ScriptReader script;
+    Loop loops[MAX_DEPTH];
+    char path[sizeof(someMsg.msg)];
+
+    for(;;)
+    {
+        xQueueReceive(scriptQueue, (void *)&someMsg, portMAX_DELAY);            // Sleep until `run <file>`
+
+        char *tailPtr = someMsg.msg + 4;                                        // pointer arithmetic: move pointer to the path
+        tailPtr[strcspn(tailPtr, "\r\n")] = '\0';
+        snprintf(path, sizeof(path), "%s%s", (tailPtr[0] == '/') ? "" : "/", tailPtr);
+
+        script.file = SD.open(path);
+        if(!script.file)
+        {
+            serialOut.printf("Failed to open script: %s\n", path);
+            continue;
+        }
+        script.pos = 0;
+        script.len = 0;
+
+        uint32_t lineCount = 0;
+        uint8_t depth = 0;
+        uint32_t start = millis();
+        scriptAbort = false;
+        ulTaskNotifyTake(pdTRUE, 0);                                            // Drop a `stop` sent while no script ran
+        serialOut.printf("Running script: %s\n", path);
+
+        while(!scriptAbort && script.readLine(lineMsg.msg, sizeof(lineMsg.msg) - 1))
+        {
+            char *line = lineMsg.msg + strspn(lineMsg.msg, " \t");              // Indentation is allowed
+            lineCount++;
+
+            if(line[0] == '\0' || line[0] == '#')                               // Blank line or comment
             {
-                lightsOff = false;
-                if(accessLEDCAnalog == 1)
-                {
-                    ledcAnalogWrite(LEDCchan, 0);                               // Only Need to do this ONCE
-                    accessLEDCAnalog = 0;
-                }
-                brightness += fadeInterval;                                     // Adjust brightness by fadeInterval
-                if(brightness <= 0)                                             // Only change color if value <= 0
-                {
-                    brightness = 0;
-                    fadeInterval = -fadeInterval;                               // Reverse fade effect
-                    swap = !swap;                                               // swap colors
-                    if(swap)
-                    {
-                        leds[0] = CRGB::Blue;
-                    }
-                    else
-                    {
-                        leds[0] = CRGB::Red;
-                    }
-                }
-                else if(brightness >= 255)
-                {
-                    brightness = 255;
-                    fadeInterval = -fadeInterval;                               // Reverse fade effect
-                }
-                FastLED.setBrightness(brightness);
-                FastLED.show();
+                continue;
             }
-            else if(patternType == 3)                                           // Rotate Colors w/o fade
+            else if(memcmp(line, waitDirective, 5) == 0)                        // `wait <ms>`: script task sleeps, CLI stays live
             {
-                lightsOff = false;
-                if(accessLEDCAnalog == 1)
-                {
-                    ledcAnalogWrite(LEDCchan, 0);                               // Only Need to do this ONCE
-                    accessLEDCAnalog = 0;
-                }
-                brightness = brightVal;                                         // Pull value from global integer
-                hueVal += fadeInterval;                                         // Change color based on global value
-                if(hueVal >= 255)
-                {
-                    hueVal = 0;                         
-                }
-                leds[0] = CHSV(hueVal, 255, 255);                               // Rotate Colors 0 - 255
-                FastLED.setBrightness(brightness);
-                FastLED.show();
+                ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(abs(atoi(line + 5))));   // `stop` ends the wait at once
             }
-            else if(patternType == 4)                                           // Blue LED (Pin 13) Fades on/off
+            else if(memcmp(line, repeatDirective, 7) == 0)                      // `repeat N` ... `end`
             {
-                lightsOff = false;
-                if(accessLEDCAnalog == 0)
+                char *countEnd;
+                long count = strtol(line + 7, &countEnd, 10);
+                if(countEnd == line + 7)
                 {
-                    leds[0] = CRGB::Black;                                      // Turn Off RGB LED
-                    FastLED.show();
-                    accessLEDCAnalog = 1;                                       // Only need to do this ONCE
+                    serialOut.printf("Script line %u: repeat needs a count\n", lineCount);
+                    break;
                 }
-                brightness += fadeInterval;                                     // Adjust brightness by fadeInterval
-                if(brightness <= 0)                                             // Reverse fade effect at min/max values
+                if(count < 1)                                                   // Block runs 0 times: skip it, nested blocks too
                 {
-                    brightness = 0;
-                    fadeInterval = -fadeInterval;
+                    if(!skipRepeatBlock(script, lineMsg.msg, sizeof(lineMsg.msg) - 1, lineCount))
+                    {
+                        serialOut.printf("Script line %u: repeat without end\n", lineCount);
+                        break;
+                    }
+                    continue;
                 }
-                else if(brightness >= 255)
+                if(depth >= MAX_DEPTH)
                 {
-                    brightness = 255;
-                    fadeInterval = -fadeInterval;
+                    serialOut.printf("Script line %u: repeat nested too deep\n", lineCount);
+                    break;
                 }
-                ledcAnalogWrite(LEDCchan, brightness);                          // Set brightness on LEDC channel 0
+                loops[depth].start = script.offset();
+                loops[depth].remaining = count;
+                depth++;
             }
-            else if(patternType == 5)                                           // Blue LED (pin 13) Cycles on/off
+            else if(memcmp(line, endDirective, 3) == 0)
             {
-                lightsOff = false;
-                if(accessLEDCAnalog == 0)
+                if(depth == 0)
                 {
-                    leds[0] = CRGB::Black;                                      // Turn Off RGB LED
-                    FastLED.show();
-                    accessLEDCAnalog = 1;                                       // Only need to do this ONCE
+                    serialOut.printf("Script line %u: end without repeat\n", lineCount);
+                    break;
                 }
-                swap = !swap;
-                if(swap)
+                if(--loops[depth - 1].remaining > 0)
                 {
-                    ledcAnalogWrite(LEDCchan, 255);
+                    script.seek(loops[depth - 1].start);                        // Replay the block from SD, not from RAM
                 }
                 else
                 {
-                    ledcAnalogWrite(LEDCchan, 0);
+                    depth--;
                 }
             }
-            else                                                                // Turn Off Everything
+            else                                                                // Anything else is a CLI command
             {
-                if(lightsOff == false)
-                {
-                    lightsOff = true;
-                    if(accessLEDCAnalog == 0)
-                    {
-                        leds[0] = CRGB::Black;                                  // Turn Off RGB LED
-                        FastLED.show();
-                    }
-                    else // RGB LED already off
-                    {
-                        ledcAnalogWrite(LEDCchan, 0);                           // Turn off Blue LED
-                    }
-                    Serial.println("Invalid Pattern...Turning Lights Off!!\n");
-                }
+                memmove(lineMsg.msg, line, strlen(line) + 1);
+                strncat(lineMsg.msg, "\n", sizeof(lineMsg.msg) - strlen(lineMsg.msg) - 1);
+                lineMsg.stamp = LatencyStats::now();
+                xQueueSend(msgQueue, (void *)&lineMsg, portMAX_DELAY);          // Same dispatcher as typed input: wait, don't drop
             }
         }
-        vTaskDelay(delayInterval / portTICK_PERIOD_MS);                         // CLI adjustable delay (non blocking)
+        script.file.close();
+
+        serialOut.printf("Script %s: %s after %u lines, %lums\n\n", path, scriptAbort ? "stopped" : "done",
+                         lineCount, millis() - start);
     }
 }
 
-void SDCardTask(void *param) /*** Receives Valid Commands From `msgRXTask` where they are originally parsed e***/
+size_t readAnimationFrame(File &file, const AnimationHeader &header, uint8_t *staging, CRGB *dest) // 0 = end of file / bad frame
 {
-    SDCommand SDCmd;
-    char buffer[BUF_LEN];
-
-    /*** SD Command Handling ***/
-    if(xQueueReceive(sdQueue, (void *)&SDCmd, 0) == pdTRUE)                     // if command received from SD QUEUE
+    size_t len = header.leds * sizeof(CRGB);
+    if(header.encoding == ANIM_RLE)
     {
-        if(memcmp(SDCmd.cmd, sdListCmds, 5) == 0)                               // if `lscmd` command rec'd (compare to global var)
-        {             
-            char* tailPtr = SDCmd.cmd + 5;
-
-        }
-        else if(memcmp(SDCmd.cmd, sdListDir, 6) == 0)                           // if `lsdir ` command rec'd (compare to global var)
+        uint8_t prefix[2];
+        if(file.read(prefix, 2) != 2)
         {
-            // memset(buffer, 0, BUF_LEN);  
+            return 0;
         }
-        else if(memcmp(SDCmd.cmd, sdCreateDir, 6) == 0)                         // if `mkdir ` command rec'd (compare to global var)
+        len = prefix[0] | (prefix[1] << 8);
+        if(len > header.maxFrameBytes())
         {
+            return 0;
+        }
+    }
+    if(file.read(staging, len) != len)                                          // 1 SD read per frame
+    {
+        return 0;
+    }
+
+    if(header.encoding == ANIM_RLE)
+    {
+        return decodeRle(staging, len, dest, NUM_LEDS) ? len + 2 : 0;
+    }
+    decodeRaw(staging, header.leds, dest, NUM_LEDS);
+    return len;
+}
 
+void playTask(void *param) /*** Streams `play <file>` animations from SD, 1 frame ahead of the LEDs ***/
+{
+    Message someMsg;
+    LedParams current;
+    AnimationHeader header;
+    uint8_t raw[AnimationHeader::SIZE];
+    char path[sizeof(someMsg.msg)];
+
+    for(;;)
+    {
+        xQueueReceive(playQueue, (void *)&someMsg, portMAX_DELAY);              // Sleep until `play <file>`
+        playAbort = false;
+
+        char *tailPtr = someMsg.msg + 5;                                        // pointer arithmetic: move pointer to the path
+        tailPtr[strcspn(tailPtr, "\r\n")] = '\0';
+        snprintf(path, sizeof(path), "%s%s", (tailPtr[0] == '/') ? "" : "/", tailPtr);
+
+        File file = SD.open(path);
+        if(!file)
+        {
+            serialOut.printf("Failed to open animation: %s\n", path);
+            continue;
         }
-        else if(memcmp(SDCmd.cmd, sdDeleteDir, 6) == 0)                         // if `rmdir ` command rec'd (compare to global var)
+        if(file.read(raw, sizeof(raw)) != sizeof(raw) || !header.parse(raw))
         {
-            // memset(buffer, 0, BUF_LEN);
+            serialOut.printf("Not a playable animation: %s\n", path);
+            file.close();
+            continue;
         }
-        else if(memcmp(SDCmd.cmd, sdReadFile, 9) == 0)                          // if `readfile ` command rec'd (compare to global var)
+        uint8_t *staging = (uint8_t *)pvPortMalloc(header.maxFrameBytes());     // Freed after the file: no RAM kept between plays
+        if(staging == NULL)
         {
+            serialOut.println("Not Enough Heap For Animation\n");
+            file.close();
+            continue;
+        }
 
-        }       
-        else if(memcmp(SDCmd.cmd, sdWriteFile, 10) == 0)                        // if `writefile ` command rec'd
+        serialOut.printf("Playing %s: %u LEDs @ %u fps, %s\n", path, header.leds, header.fps,
+                         (header.encoding == ANIM_RLE) ? "RLE" : "raw");
+        animation.start(header.fps);
+        LatencyTrace trace = { LatencyStats::now(), LatencyStats::now(), 0 };
+        dispatchCommand(OP_PATTERN, PLAY_PATTERN, portMAX_DELAY, trace);        // Wakes the LED task if it was idle
+
+        uint32_t frames = 0;
+        const char *result = "done";
+        while(header.frames == 0 || frames < header.frames)
         {
-            // memset(buffer, 0, BUF_LEN);
+            ledParams.read(current);
+            if(playAbort || current.pattern != PLAY_PATTERN)                    // `stop`, `play` or another pattern
+            {
+                result = "stopped";
+                break;
+            }
+            CRGB *dest = animation.fill(pdMS_TO_TICKS(100));                    // Both halves full: wait for the LED task
+            if(dest == NULL)
+            {
+                continue;
+            }
+            int64_t start = esp_timer_get_time();
+            size_t bytes = readAnimationFrame(file, header, staging, dest);
+            if(bytes == 0)
+            {
+                if(header.frames != 0 || file.available() > 0)
+                {
+                    result = "bad frame";
+                }
+                break;
+            }
+            animation.filled(bytes, (uint32_t)(esp_timer_get_time() - start));
+            frames++;
         }
-        else if(memcmp(SDCmd.cmd, sdAppendFile, 7) == 0)                        // if `append ` command rec'd
+        if(strcmp(result, "done") == 0)
         {
-            // memset(buffer, 0, BUF_LEN);
+            animation.drain(pdMS_TO_TICKS(1000));                               // Let the last 2 frames go out first
         }
-        else if(memcmp(SDCmd.cmd, sdRenameFile, 7) == 0)                        // if `rename ` command rec'd
-        {
+        animation.finish();
+        file.close();
+        vPortFree(staging);
+
+        uint32_t fps = animation.fpsX10();
+        serialOut.printf("Animation %s: %s, %u frames read, %u shown, %u underruns, %u.%u fps sustained\n", path, result,
+                         frames, animation.shown(), animation.underruns(), fps / 10, fps % 10);
+        serialOut.printf("SD: %ukB read @ %ukB/s, busy %u%% of the time\n\n", (uint32_t)(animation.bytes() / 1024),
+                         animation.readKBps(), animation.busyPercent());
+    }
+}
+
+void schedulerTask(void *param) /*** Runs `at` / `every` commands when they come due ***/
+{
+    static CmdScheduler<SchedSize, sizeof(Message::msg)> sched;                 // ~1.5kB: keep it off the task stack
+    Message someMsg;
+    char *tailPtr;
+    uint32_t dropped = 0;                                                       // Due commands lost to a full `msgQueue`
 
+    for(;;)
+    {
+        TickType_t now = xTaskGetTickCount();
+        TickType_t wait = portMAX_DELAY;                                        // Nothing scheduled: sleep until a request
+        if(sched.peek() != NULL)
+        {
+            TickType_t due = sched.peek()->deadline;
+            wait = sched.before(now, due) ? (due - now) : 0;                    // Sleep exactly until the next deadline
         }
-        else if(memcmp(SDCmd.cmd, sdDeleteFile, 7) == 0)                        // if `rmfile ` command rec'd
+
+        if(xQueueReceive(schedQueue, (void *)&someMsg, wait) == pdTRUE)         // New request: handle, then recompute sleep
         {
+            now = xTaskGetTickCount();
+            someMsg.msg[strcspn(someMsg.msg, "\r\n")] = '\0';
+
+            if(memcmp(someMsg.msg, jobsCmd, 4) == 0)                            // `jobs`: list, earliest first at the top
+            {
+                serialOut.printf("%u Scheduled Command(s), %u Runs Dropped:\n", sched.size(), dropped);
+                for(size_t i = 0; i < sched.size(); i++)
+                {
+                    const auto &entry = sched.entry(i);
+                    serialOut.printf("  #%u in %dms every %ums: %s\n", entry.id,
+                                     (int)(entry.deadline - now) * portTICK_PERIOD_MS, entry.period * portTICK_PERIOD_MS, entry.cmd);
+                }
+                serialOut.print("\n");
+            }
+            else if(memcmp(someMsg.msg, cancelCmd, 7) == 0)                     // `cancel <id>`
+            {
+                int id = atoi(someMsg.msg + 7);
+                serialOut.printf(sched.cancel(id) ? "Cancelled #%d\n\n" : "No Scheduled Command #%d\n\n", id);
+            }
+            else                                                                // `at <ms|+ms> <cmd>` or `every <ms> <cmd>`
+            {
+                bool every = (memcmp(someMsg.msg, everyCmd, 6) == 0);
+                tailPtr = someMsg.msg + (every ? 6 : 3);
+                bool relative = every || (*tailPtr == '+');                     // `at 5000` = 5s after boot, `at +5000` = 5s from now
+                uint32_t ms = strtoul(tailPtr + (*tailPtr == '+'), &tailPtr, 10);
+                tailPtr += strspn(tailPtr, " ");
+
+                if(*tailPtr == '\0' || (every && ms == 0))
+                {
+                    serialOut.println("Usage: at <ms|+ms> <command> / every <ms> <command>\n");
+                    continue;
+                }
 
+                uint32_t ticks = ms / portTICK_PERIOD_MS;
+                int id = sched.add(relative ? (now + ticks) : ticks, every ? ticks : 0, tailPtr);
+                if(id < 0)
+                {
+                    serialOut.printf("Scheduler Full: Max %d Commands\n\n", SchedSize);
+                }
+                else
+                {
+                    serialOut.printf("Scheduled #%d: %s\n\n", id, tailPtr);
+                }
+            }
+            continue;
         }
-        else if(memcmp(SDCmd.cmd, sdUsedSpace, 7) == 0)                         // if `lsbytes` command rec'd
+
+        now = xTaskGetTickCount();                                              // Timed out: run everything that is due
+        while(sched.peek() != NULL && !sched.before(now, sched.peek()->deadline))
         {
-            uint64_t cardSize = SD.cardSize() / (1024 * 1024);
-            sprintf(buffer, "\n\nSD Card Size: %lluMB\n", cardSize);
-            memset(buffer, 0, BUF_LEN);
-            sprintf(buffer, "Total space: %lluMB\n", SD.totalBytes() / (1024 * 1024));
-            Serial.println(buffer);
-            memset(buffer, 0, BUF_LEN);
-            sprintf(buffer, "Used space: %lluMB\n\n", SD.usedBytes() / (1024 * 1024));
-            Serial.println(buffer);
-            memset(buffer, 0, BUF_LEN);
+            snprintf(someMsg.msg, sizeof(someMsg.msg), "%s\n", sched.peek()->cmd);
+            someMsg.stamp = LatencyStats::now();
+            if(xQueueSend(msgQueue, (void *)&someMsg, 10) != pdTRUE)            // Same dispatcher as typed input
+            {
+                dropped++;
+                serialOut.printf("Scheduled #%u Dropped: CLI Queue Full\n", sched.peek()->id);
+            }
+            sched.fired(now);
         }
-        vTaskDelay(15 / portTICK_PERIOD_MS);                                    // yield briefly (only if command rec'd)
     }
-    else { /* do something else if there is no command */ }
 }
+
 void setup()
 {
     msgQueue = xQueueCreate(QueueSize, sizeof(Message));                        // Instantiate message queue
     ledQueue = xQueueCreate(QueueSize, sizeof(Command));                        // Instantiate command queue
-    sdQueue = xQueueCreate(QueueSize, sizeof(Command));                         // Instantiate SD Card Queue
+    sdService.begin(QueueSize);                                                 // Instantiate SD Card request queue
+    scriptQueue = xQueueCreate(1, sizeof(Message));                             // 1 pending `run` at a time
+    playQueue = xQueueCreate(1, sizeof(Message));                               // 1 pending `play` at a time
+    schedQueue = xQueueCreate(QueueSize, sizeof(Message));                      // Requests for `schedulerTask`
 
     Serial.begin(115200);
     vTaskDelay(1000 / portTICK_PERIOD_MS);
-    Serial.println("\n\n=>> FreeRTOS RGB LED Color Wheel & SD Card Demo <<=");
+    serialOut.begin(Serial, app_cpu);                                           // All output goes through the TX ring from here on
+
+    cliEvents.addSerial(Serial);                                                // Queues must be empty when they join a set
+    msgEvents.addQueue(msgQueue, QueueSize);
+    if(!cliEvents.begin() || !msgEvents.begin())
+    {
+        Serial.println("ERROR: Could Not Create Queue Sets. Restarting...");
+        vTaskDelay(1000 / portTICK_PERIOD_MS);
+        ESP.restart();
+    }
+    serialOut.println("\n\n=>> FreeRTOS RGB LED Color Wheel & SD Card Demo <<=");
 
-    FastLED.addLeds <CHIPSET, RGB_LED, COLOR_ORDER> (leds, NUM_LEDS).setCorrection(TypicalLEDStrip);
+    CLEDController &stripLeds = FastLED.addLeds <CHIPSET, RGB_LED, COLOR_ORDER> (frameA, NUM_LEDS);
+    stripLeds.setCorrection(TypicalLEDStrip);
+    FastLED.setMaxPowerInVoltsAndMilliamps(5, StripMaxMilliamps);
     FastLED.setBrightness(75);
-    leds[0] = CRGB::White;                                                      // Power up all Pin 2 LEDs for Power On Test
+    fill_solid(frameA, NUM_LEDS, CRGB::White);                                  // Power up all Pin 2 LEDs for Power On Test
     FastLED.show();
     
     ledcSetup(LEDCchan, LEDCfreq, LEDCtimer);                                   // Setup LEDC timer 
     ledcAttachPin(BLUE_LED, LEDCchan);                                          // Attach timer to LED pin
     vTaskDelay(2000 / portTICK_PERIOD_MS);                                      // 2 Second Power On Delay
 
-    Serial.println("Power On Test Complete...Starting Tasks");
+    serialOut.println("Power On Test Complete...Starting Tasks");
 
-    leds[0] = CRGB::Black;
+    fill_solid(frameA, NUM_LEDS, CRGB::Black);
     FastLED.show();
+    strip.begin(stripLeds, app_cpu);                                            // From here on only the output task calls `show()`
+    attachAnimation(animation);
     
     vTaskDelay(500 / portTICK_PERIOD_MS);                                       // 0.5 Second off before Starting Tasks
 
+    xTaskCreatePinnedToCore(                                                    // Instantiate SD Card task: it mounts the card
+        SDCardTask,
+        "SD Card Handler",
+        4096,
+        NULL,
+        1,
+        NULL,
+        app_cpu
+    );
+
+    SDRequest mount = {};
+    SDResult mounted;
+    mount.op = SD_OP_MOUNT;
+    if(sdService.call(mount, mounted) != SD_ST_OK)                              // Only `setup()` waits for the card
+    {
+        serialOut.println("Card Mount Failed: Retried With The Next SD Command");
+    }
+
     xTaskCreatePinnedToCore(                                                    // Instantiate CLI Terminal
         userCLITask,
         "Serial CLI Terminal",
@@ -835,7 +1590,7 @@ void setup()
         app_cpu
     );
 
-    Serial.println("User CLI Task Instantiation Complete");
+    serialOut.println("User CLI Task Instantiation Complete");
 
     xTaskCreatePinnedToCore(                                                    // Instantiate Message RX Task
         msgRXTask,
@@ -847,7 +1602,7 @@ void setup()
         app_cpu
     );
 
-    Serial.println("Message RX Task Instantiation Complete");
+    serialOut.println("Message RX Task Instantiation Complete");
 
     xTaskCreatePinnedToCore(                                                    // Instantiate LED fade task
         RGBcolorWheelTask,
@@ -855,13 +1610,15 @@ void setup()
         2048,
         NULL,
         1,
-        NULL,
+        &ledTask,
         app_cpu
     );
 
-    xTaskCreatePinnedToCore(                                                    // Instantiate SD Card task
-        SDCardTask,
-        "SD Card Handler",
+    serialOut.println("RGB LED Task Instantiation Complete");                   // debug
+
+    xTaskCreatePinnedToCore(                                                    // Instantiate command scheduler task
+        schedulerTask,
+        "Command Scheduler",
         2048,
         NULL,
         1,
@@ -869,15 +1626,43 @@ void setup()
         app_cpu
     );
 
-    Serial.println("RGB LED Task Instantiation Complete");                      // debug
+    xTaskCreatePinnedToCore(                                                    // Instantiate script runner task
+        scriptTask,
+        "Script Runner",
+        3072,
+        NULL,
+        1,
+        &scriptRunner,
+        app_cpu
+    );
+
+    xTaskCreatePinnedToCore(                                                    // Instantiate animation player task
+        playTask,
+        "Animation Player",
+        3072,
+        NULL,
+        1,
+        NULL,
+        app_cpu
+    );
 
-    Serial.print("\n\nEnter \'delay xxx\' to change RGB Fade Speed.\n");
-    Serial.print("Enter \'fade xxx\' to change RGB Fade Amount.\n");
-    Serial.print("Enter \'pattern xxx\' to change RGB Pattern.\n");
-    Serial.print("Enter \'bright xxx\' to change RGB Brightness (Only Pattern 3).\n");
-    Serial.print("Enter \'cpu xxx\' to change CPU Frequency.\n");
-    Serial.print("Enter \'values\' to retrieve current delay, fade, pattern & bright values.\n");
-    Serial.print("Enter \'freq\' to retrieve current CPU, XTAL & APB Frequencies.\n\n");
+    serialOut.print("\n\nEnter \'delay xxx\' to change RGB Fade Speed.\n");
+    serialOut.print("Enter \'fade xxx\' to change RGB Fade Amount.\n");
+    serialOut.print("Enter \'pattern xxx\' to change RGB Pattern.\n");
+    serialOut.print("Enter \'bright xxx\' to change RGB Brightness (Only Pattern 3).\n");
+    serialOut.print("Enter \'cpu xxx\' to change CPU Frequency.\n");
+    serialOut.print("Enter \'values\' to retrieve current delay, fade, pattern & bright values.\n");
+    serialOut.print("Enter \'freq\' to retrieve current CPU, XTAL & APB Frequencies.\n");
+    serialOut.print("Enter \'xfade xxx\' to set the pattern crossfade time in ms (0 = instant).\n");
+    serialOut.print("Enter \'bench [leds]\' to time the crossfade blend per LED.\n");
+    serialOut.print("Enter \'run <file>\' to run a command script from SD (\'stop\' aborts it).\n");
+    serialOut.print("Enter \'play <file>\' to play a pre-rendered animation from SD (pattern 6).\n");
+    serialOut.print("Enter \'at <ms|+ms> <cmd>\' or \'every <ms> <cmd>\' to schedule a command.\n");
+    serialOut.print("Enter \'jobs\' to list scheduled commands, \'cancel <id>\' to remove one.\n");
+    serialOut.print("Enter \'lscmd\' to list the SD card commands (mkdir, readfile, append...).\n");
+    serialOut.print("Enter \'perf\' for command & SD latency per pipeline hop (\'perf reset\' clears it).\n");
+    serialOut.print("Enter \'binmode\' to switch to binary frames for host automation.\n");
+    serialOut.print("Up/Down recall previous commands, Left/Right/Home/End & Backspace edit the line.\n\n");
 
     vTaskDelete(NULL);                                                          // Self Delete setup() & loop()
 }
@@ -4,17 +4,22 @@
  * example here, written for Arduino: https://github.com/sparkfun/SparkFun_Thing_Plus_ESP32_WROOM_C
  * Edited for readability and proper functionality. This is meant to be integrated to the Command
  * Line Interface after modifications are complete.
+ * `readFile` streams 4kB blocks through `lib/BlockReader`, `compareReads` times it against
+ * the old 1 byte per `file.read()` loop.
 */
 #include "FS.h"
 #include "SD.h"
 #include <SPI.h>
 #include <Arduino.h>
+#include "BlockReader.h" // lib/BlockReader: block-aligned file range streaming
 
 #define SD_CS 5
 #define SD_SCK 18
 #define SD_MISO 19
 #define SD_MOSI 23
 
+static BlockReader<4096> reader; // 1 reusable 4kB block buffer for every read
+
 void listDir(fs::FS &fs, const char * dirname, uint8_t levels) 
 {
     Serial.printf("Listing directory: %s\n", dirname);
@@ -92,11 +97,49 @@ void readFile(fs::FS &fs, const char * path)
     }
 
     Serial.print("Read from file: ");
-    while (file.available())
+    reader.stream(file, 0, BlockReader<4096>::TO_END, 0, [](const char *data, size_t len)
     {
-        Serial.write(file.read());
+        Serial.write((const uint8_t *)data, len); // 1 block per call instead of 1 byte
+    });
+    file.close();
+}
+
+void compareReads(fs::FS &fs, const char * path, uint32_t length)
+{
+    File file = fs.open(path);
+    if (!file)
+    {
+        Serial.println("Failed to open file for reading");
+        return;
     }
+    length = min(length, (uint32_t)file.size());
+
+    uint32_t sum = 0; // Keeps the compiler from dropping the reads
+    uint32_t start = micros();
+    for (uint32_t i = 0; i < length; i++)
+    {
+        sum += file.read(); // Old `readFile`: 1 call per byte
+    }
+    uint32_t byteUs = max((uint32_t)(micros() - start), (uint32_t)1);
+
+    uint32_t blockSum = 0;
+    reader.stream(file, 0, length, 0, [&blockSum](const char *data, size_t len)
+    {
+        for (size_t i = 0; i < len; i++)
+        {
+            blockSum += (uint8_t)data[i];
+        }
+    });
+    uint32_t blockUs = max(reader.lastReadUs(), (uint32_t)1);
     file.close();
+
+    Serial.printf("%u bytes per byte: %u ms (%u kB/s)\n", length, byteUs / 1000, (uint32_t)((uint64_t)length * 1000000 / 1024 / byteUs));
+    Serial.printf("%u bytes in 4kB blocks: %u ms (%u kB/s), %u.%ux faster\n", reader.lastBytes(), blockUs / 1000,
+                  (uint32_t)((uint64_t)reader.lastBytes() * 1000000 / 1024 / blockUs), byteUs / blockUs, byteUs * 10 / blockUs % 10);
+    if (sum != blockSum)
+    {
+        Serial.println("Read mismatch: both passes should see the same bytes");
+    }
 }
 
 void writeFile(fs::FS &fs, const char * path, const char * message)
@@ -299,6 +342,9 @@ void setup()
     testFileIO(SD, "/foo.txt");
     Serial.print("End testFileIO (foo.txt)\n\n");
 
+    compareReads(SD, "/test.txt", 256 * 1024);
+    Serial.print("End compareReads (test.txt)\n\n");
+
     Serial.printf("Total space: %lluMB\n", SD.totalBytes() / (1024 * 1024));
     Serial.printf("Used space: %lluMB\n", SD.usedBytes() / (1024 * 1024));
 }
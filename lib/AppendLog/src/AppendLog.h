@@ -0,0 +1,275 @@
+/**
+ * Joel Brigida
+ * October 18, 2026
+ * Append-only log file that stays open. The file is preallocated once: a 512 B header sector,
+ * then `capacity` bytes of zeros. Appends then overwrite clusters the FAT already maps, so no
+ * cluster is allocated & the FAT is not touched per line, like `appendFile` did. Lines collect
+ * in a RAM buffer & reach the card when:
+ *     size:  the buffer is full (data only, the header is not rewritten)
+ *     time:  `poll()` finds data older than `flushMs`
+ *     sync:  `sync()` is called (also from `close()`)
+ * A time or explicit sync writes the data, syncs, then rewrites the header with the new valid
+ * length & syncs again, so the header never covers data that isn't on the card. `open()` of
+ * an existing log only reads the header: after a power loss, at most the data since the last
+ * sync is lost & recovery doesn't scan the file. A log of another capacity is recreated empty.
+ * Header (little-endian): "ALOG", version (1), capacity, valid length, check (~length ^ capacity)
+ * Usage:
+ *     static AppendLog<4096> log;
+ *     log.open(SD, "/cli.alog", 1024 * 1024);                 // Creates & preallocates 1MB once
+ *     log.append(line, len);                                  // Usually just a copy into RAM
+ *     log.poll();                                             // Every ~`msUntilSync()` from the owner task
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include "FS.h"
+
+template <size_t BufSize = 4096>
+class AppendLog
+{
+    static_assert(BufSize >= 512 && (BufSize & (BufSize - 1)) == 0, "buffer: whole SD sectors");
+
+public:
+    enum { HEADER_SIZE = 512 };                                                 // Data starts on the 2nd sector
+    enum { VERSION = 1 };
+    enum : uint32_t { NEVER = 0xFFFFFFFF };                                     // `msUntilSync()`: nothing buffered
+
+    bool open(fs::FS &fs, const char *path, uint32_t capacity, uint32_t flushMs = 1000) // false: card / file error
+    {
+        close();
+        interval = flushMs;
+        file = fs.open(path, "r+");                                             // Existing log of this capacity: keep its data
+        if(file && readHeader() && cap == capacity && file.size() >= HEADER_SIZE + cap)
+        {
+            return true;
+        }
+        file.close();
+
+        int64_t start = esp_timer_get_time();
+        file = fs.open(path, FILE_WRITE);                                       // New, broken or resized log: preallocate it
+        cap = capacity;
+        length = 0;
+        memset(buffer, 0, BufSize);
+        buffered = 0;
+        bool ok = (bool)file;
+        for(uint32_t done = 0; ok && done < HEADER_SIZE + cap; done += BufSize)  // Sequential zeros: FAT allocates clusters in a row
+        {
+            size_t chunk = (HEADER_SIZE + cap - done < BufSize) ? HEADER_SIZE + cap - done : BufSize;
+            ok = file.write(buffer, chunk) == chunk;
+        }
+        ok = ok && writeHeader();
+        file.close();
+        preallocUs = (uint32_t)(esp_timer_get_time() - start);
+        file = ok ? fs.open(path, "r+") : File();
+        return (bool)file;
+    }
+
+    bool append(const char *data, size_t len)                                   // false: log full or not open, nothing written
+    {
+        if(!file || length + buffered + len > cap)
+        {
+            droppedCount++;
+            return false;
+        }
+        if(buffered == 0 && synced == length)                                   // 1st byte since the last sync starts the clock
+        {
+            oldestMs = nowMs();
+        }
+        while(len > 0)
+        {
+            size_t chunk = (len < BufSize - buffered) ? len : BufSize - buffered;
+            memcpy(buffer + buffered, data, chunk);
+            buffered += chunk;
+            data += chunk;
+            len -= chunk;
+            if(buffered == BufSize && !writeBuffered())                         // Size flush: data only
+            {
+                return false;
+            }
+        }
+        appendCount++;
+        return true;
+    }
+
+    bool sync()                                                                 // Buffer & valid length on the card
+    {
+        if(!file)
+        {
+            return false;
+        }
+        bool ok = writeBuffered();
+        file.flush();                                                           // Data first...
+        ok = ok && writeHeader();
+        file.flush();                                                           // ...then the length that covers it
+        syncCount++;
+        return ok;
+    }
+
+    bool truncate()                                                             // Empty in place: header only, no FAT change
+    {
+        if(!file)
+        {
+            return false;
+        }
+        buffered = 0;
+        length = 0;
+        bool ok = writeHeader();
+        file.flush();
+        return ok;
+    }
+
+    uint32_t msUntilSync()                                                      // For the owner task's sleep
+    {
+        if(buffered == 0 && synced == length)
+        {
+            return NEVER;
+        }
+        uint32_t age = nowMs() - oldestMs;
+        return (age >= interval) ? 0 : interval - age;
+    }
+
+    void poll()                                                                 // Time flush: sync once data is `flushMs` old
+    {
+        if(msUntilSync() == 0)
+        {
+            sync();
+        }
+    }
+
+    void close()
+    {
+        if(file)
+        {
+            sync();
+            file.close();
+        }
+    }
+
+    bool isOpen()
+    {
+        return (bool)file;
+    }
+
+    /*** Stats ***/
+
+    uint32_t size() const                                                       // Valid data bytes, incl. the RAM buffer
+    {
+        return length + buffered;
+    }
+
+    uint32_t syncedSize() const                                                 // Survives a power loss
+    {
+        return synced;
+    }
+
+    uint32_t capacity() const
+    {
+        return cap;
+    }
+
+    uint32_t appends() const
+    {
+        return appendCount;
+    }
+
+    uint32_t writes() const                                                     // Buffer writes to the card
+    {
+        return writeCount;
+    }
+
+    uint32_t syncs() const
+    {
+        return syncCount;
+    }
+
+    uint32_t dropped() const                                                    // Appends refused: log full
+    {
+        return droppedCount;
+    }
+
+    uint32_t preallocateUs() const                                              // Last time `open()` created the file
+    {
+        return preallocUs;
+    }
+
+private:
+    static uint32_t nowMs()
+    {
+        return (uint32_t)(esp_timer_get_time() / 1000);
+    }
+
+    static void put32(uint8_t *raw, uint32_t value)
+    {
+        raw[0] = value;
+        raw[1] = value >> 8;
+        raw[2] = value >> 16;
+        raw[3] = value >> 24;
+    }
+
+    static uint32_t get32(const uint8_t *raw)
+    {
+        return raw[0] | (raw[1] << 8) | ((uint32_t)raw[2] << 16) | ((uint32_t)raw[3] << 24);
+    }
+
+    bool readHeader()
+    {
+        uint8_t raw[20];
+        if(!file.seek(0) || file.read(raw, sizeof(raw)) != sizeof(raw))
+        {
+            return false;
+        }
+        cap = get32(raw + 8);
+        length = get32(raw + 12);
+        synced = length;
+        buffered = 0;
+        return memcmp(raw, "ALOG", 4) == 0 && get32(raw + 4) == VERSION && length <= cap &&
+               get32(raw + 16) == (~length ^ cap);
+    }
+
+    bool writeHeader()                                                          // 1 sector: written whole by the card
+    {
+        uint8_t raw[20];
+        memcpy(raw, "ALOG", 4);
+        put32(raw + 4, VERSION);
+        put32(raw + 8, cap);
+        put32(raw + 12, length);
+        put32(raw + 16, ~length ^ cap);
+        if(!file.seek(0) || file.write(raw, sizeof(raw)) != sizeof(raw))
+        {
+            return false;
+        }
+        synced = length;
+        return true;
+    }
+
+    bool writeBuffered()
+    {
+        if(buffered == 0)
+        {
+            return true;
+        }
+        if(!file.seek(HEADER_SIZE + length) || file.write(buffer, buffered) != buffered)
+        {
+            return false;
+        }
+        length += buffered;
+        buffered = 0;
+        writeCount++;
+        return true;
+    }
+
+    File file;
+    uint8_t buffer[BufSize];
+    size_t buffered = 0;                                                        // Bytes in `buffer`, not on the card yet
+    uint32_t length = 0;                                                        // Data bytes written to the file
+    uint32_t synced = 0;                                                        // `length` in the header on the card
+    uint32_t cap = 0;
+    uint32_t interval = 1000;
+    uint32_t oldestMs = 0;                                                      // When the oldest unsynced byte arrived
+    uint32_t appendCount = 0;
+    uint32_t writeCount = 0;
+    uint32_t syncCount = 0;
+    uint32_t droppedCount = 0;
+    uint32_t preallocUs = 0;
+};
@@ -0,0 +1,119 @@
+/**
+ * Joel Brigida
+ * October 18, 2026
+ * Per-core record rings & drain task for `BLOG()`. Each core only ever writes to its
+ * own ring, with interrupts masked on that core for the few cycles of the copy, so a
+ * ring has exactly 1 producer at a time & no spinlock is shared between the cores.
+ * The drain task is the single consumer of both rings.
+ */
+
+#include "BinLog.h"
+#include <atomic>
+
+namespace BinLog
+{
+    static_assert((BINLOG_RING_LEN & (BINLOG_RING_LEN - 1)) == 0, "BINLOG_RING_LEN must be a power of 2");
+
+    enum { NUM_CORES = 2 };
+    enum { CHUNK_LEN = 256 };                                                   // Bytes handed to the UART at once
+
+    struct Ring
+    {
+        uint8_t data[BINLOG_RING_LEN];
+        std::atomic<uint32_t> head;                                             // Written by the owning core only
+        std::atomic<uint32_t> tail;                                             // Written by the drain task only
+    };
+
+    static Ring rings[NUM_CORES];
+    static std::atomic<uint32_t> droppedRecords(0);
+    static Print *out = NULL;
+    static uint32_t drainDelay = 10;
+
+    static inline void copyIn(Ring &ring, uint32_t pos, const uint8_t *src, uint32_t n)
+    {
+        for(uint32_t i = 0; i < n; i++)
+        {
+            ring.data[(pos + i) & (BINLOG_RING_LEN - 1)] = src[i];
+        }
+    }
+
+    void IRAM_ATTR commit(uint32_t id, const uint8_t *args, uint8_t len)
+    {
+        uint8_t header[HEADER_LEN];
+        uint32_t recordLen = HEADER_LEN + len;
+
+        uint32_t state = portSET_INTERRUPT_MASK_FROM_ISR();                     // No preemption on this core from here
+        uint32_t core = xPortGetCoreID();
+        uint32_t cycles = ESP.getCycleCount();                                  // Per-core CPU cycle counter
+        Ring &ring = rings[core];
+
+        uint32_t head = ring.head.load(std::memory_order_relaxed);
+        uint32_t tail = ring.tail.load(std::memory_order_acquire);
+
+        if(BINLOG_RING_LEN - (head - tail) < recordLen)
+        {
+            droppedRecords.fetch_add(1, std::memory_order_relaxed);             // Full: drop the record, never wait
+        }
+        else
+        {
+            header[0] = SYNC;
+            header[1] = len;
+            header[2] = (uint8_t)core;
+            memcpy(&header[3], &id, 4);
+            memcpy(&header[7], &cycles, 4);
+            copyIn(ring, head, header, HEADER_LEN);
+            copyIn(ring, head + HEADER_LEN, args, len);
+            ring.head.store(head + recordLen, std::memory_order_release);       // Publish the whole record at once
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR(state);
+    }
+
+    uint32_t dropped()
+    {
+        return droppedRecords.load(std::memory_order_relaxed);
+    }
+
+    static void drainTask(void *param)
+    {
+        uint8_t chunk[CHUNK_LEN];
+
+        for(;;)
+        {
+            for(int c = 0; c < NUM_CORES; c++)
+            {
+                Ring &ring = rings[c];
+                uint32_t tail = ring.tail.load(std::memory_order_relaxed);
+                uint32_t head = ring.head.load(std::memory_order_acquire);
+
+                while(tail != head)                                             // Rings only ever hold whole records
+                {
+                    uint32_t n = 0;
+                    while(tail != head && n < CHUNK_LEN)
+                    {
+                        chunk[n++] = ring.data[tail & (BINLOG_RING_LEN - 1)];
+                        tail++;
+                    }
+                    ring.tail.store(tail, std::memory_order_release);
+                    out->write(chunk, n);
+                }
+            }
+            vTaskDelay(drainDelay / portTICK_PERIOD_MS);                        // Poll: keeps `BLOG()` free of notify calls
+        }
+    }
+
+    void begin(Print &port, BaseType_t core, UBaseType_t priority, uint32_t drainMs)
+    {
+        out = &port;
+        drainDelay = drainMs;
+
+        xTaskCreatePinnedToCore(
+            drainTask,
+            "BinLog Drain",
+            2048,
+            NULL,
+            priority,
+            NULL,
+            core
+        );
+    }
+}
@@ -0,0 +1,144 @@
+/**
+ * Joel Brigida
+ * October 18, 2026
+ * Deferred binary logging. `BLOG("fmt", args...)` does NOT format anything on the ESP32:
+ * the format string is hashed to a 32-bit ID by the compiler (FNV-1a), and at runtime
+ * only the ID, the CPU cycle count & the raw argument bytes are copied into a ring for
+ * the current core. A drain task streams the rings to the serial port, and the host
+ * tools turn the stream back into text:
+ *     python tools/binlog_dict.py src -o binlog_dict.json     // Dictionary: ID -> format string
+ *     python tools/binlog_decode.py binlog_dict.json --port /dev/ttyUSB0
+ * Plain text printed with `Serial` passes through the decoder untouched.
+ * Argument encoding (the decoder follows the conversion specifiers in the format string):
+ *     integers <= 32 bits, pointers, enums  -> 4 bytes little-endian
+ *     64-bit integers (%lld, %llu)          -> 8 bytes
+ *     float / double (%f, %e, %g)           -> 4 byte float
+ *     char * (%s)                           -> 1 length byte + up to MAX_STR_LEN characters
+ * Build with `-D BINLOG_TEXT=1` to make `BLOG()` a plain `Serial.printf()` again.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <type_traits>
+
+#ifndef BINLOG_TEXT
+#define BINLOG_TEXT 0                                                           // 1 = format on the ESP32 like before
+#endif
+
+#ifndef BINLOG_RING_LEN
+#define BINLOG_RING_LEN 2048                                                    // Bytes per core (power of 2)
+#endif
+
+namespace BinLog
+{
+    enum { SYNC = 0xB1 };                                                       // Never appears in ASCII text
+    enum { HEADER_LEN = 11 };                                                   // SYNC, len, core, id[4], cycles[4]
+    enum { MAX_ARG_BYTES = 48 };                                                // Raw argument bytes per record
+    enum { MAX_STR_LEN = 32 };                                                  // Longest `%s` argument kept
+
+    constexpr uint32_t hash(const char *str, uint32_t h = 2166136261u)          // FNV-1a: evaluated at compile time
+    {
+        return (*str == '\0') ? h : hash(str + 1, (h ^ (uint8_t)*str) * 16777619u);
+    }
+
+    void begin(Print &port, BaseType_t core, UBaseType_t priority = 1, uint32_t drainMs = 10);
+    void commit(uint32_t id, const uint8_t *args, uint8_t len);                 // Safe from any task or ISR, either core
+    uint32_t dropped();                                                         // Records lost to a full ring
+
+    /*** Argument packing: 1 overload per encoding in the table above ***/
+
+    struct Packer
+    {
+        uint8_t buf[MAX_ARG_BYTES];
+        uint8_t len = 0;
+        bool full = false;                                                      // 1 argument didn't fit: it & the rest are dropped
+
+        void raw(const void *src, uint8_t n)                                    // 1 whole argument: the decoder stops at `<truncated>`
+        {
+            if(full || len + n > MAX_ARG_BYTES)
+            {
+                full = true;
+                return;
+            }
+            memcpy(buf + len, src, n);
+            len += n;
+        }
+
+        template <typename T>
+        typename std::enable_if<(std::is_integral<T>::value || std::is_enum<T>::value) && sizeof(T) <= 4>::type
+        put(T value)
+        {
+            uint32_t word = (uint32_t)value;
+            raw(&word, 4);
+        }
+
+        template <typename T>
+        typename std::enable_if<std::is_integral<T>::value && sizeof(T) == 8>::type
+        put(T value)
+        {
+            raw(&value, 8);
+        }
+
+        template <typename T>
+        typename std::enable_if<std::is_floating_point<T>::value>::type
+        put(T value)
+        {
+            float single = (float)value;
+            raw(&single, 4);
+        }
+
+        void put(const char *str)
+        {
+            uint8_t field[1 + MAX_STR_LEN];                                     // Length & characters fit together or not at all
+            field[0] = (str == NULL) ? 0 : strnlen(str, MAX_STR_LEN);
+            if(field[0] > 0)
+            {
+                memcpy(field + 1, str, field[0]);
+            }
+            raw(field, 1 + field[0]);
+        }
+
+        void put(char *str)
+        {
+            put((const char *)str);
+        }
+
+        void put(const void *ptr)
+        {
+            uint32_t word = (uint32_t)(uintptr_t)ptr;
+            raw(&word, 4);
+        }
+
+        void packAll() {}
+
+        template <typename T, typename... Rest>
+        void packAll(T first, Rest... rest)
+        {
+            put(first);
+            packAll(rest...);
+        }
+    };
+
+    template <typename... Args>
+    inline void write(uint32_t id, Args... args)
+    {
+        Packer packer;
+        packer.packAll(args...);
+        commit(id, packer.buf, packer.len);
+    }
+}
+
+#if BINLOG_TEXT
+    #define BLOG(format, ...) Serial.printf(format, ##__VA_ARGS__)
+#else
+    #define BLOG(format, ...)                                                                   \
+        do                                                                                      \
+        {                                                                                       \
+            if(0)                                                                               \
+            {                                                                                   \
+                printf(format, ##__VA_ARGS__);      /* Type-checks args against the format */   \
+            }                                                                                   \
+            BinLog::write(std::integral_constant<uint32_t, BinLog::hash(format)>::value, ##__VA_ARGS__); \
+        } while(0)
+#endif
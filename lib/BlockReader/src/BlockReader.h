@@ -0,0 +1,136 @@
+/**
+ * Joel Brigida
+ * October 18, 2026
+ * Streams a byte range of an SD card file through 1 reusable block buffer: each `file.read()`
+ * pulls a whole block that ends on a `BlockSize` boundary of the file, so FATFS can move
+ * whole sectors instead of making 1 SPI / FAT call per byte. The blocks go to a sink (any
+ * callable taking `const char *, size_t`), e.g. the serial output ring, in block-sized chunks.
+ * `head`: stop after N lines. `tail`: `tailOffset()` walks back from the end 1 block at a time.
+ * Usage:
+ *     static BlockReader<4096> reader;                        // 4kB: keep it off small task stacks
+ *     File file = SD.open("/log.txt");
+ *     reader.stream(file, reader.tailOffset(file, 20), BlockReader<4096>::TO_END, 0,
+ *                   [](const char *data, size_t len) { Serial.write(data, len); });
+ *     Serial.printf("%u bytes, %uus reading\n", reader.lastBytes(), reader.lastReadUs());
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include "FS.h"
+
+template <size_t BlockSize = 4096>
+class BlockReader
+{
+    static_assert(BlockSize >= 512 && BlockSize <= 4096 && (BlockSize & (BlockSize - 1)) == 0,
+                  "512 B - 4 kB & a power of 2: whole SD sectors");
+
+public:
+    enum : uint32_t { TO_END = 0xFFFFFFFF };                                    // `length`: everything after `offset`
+
+    template <class Sink>
+    uint32_t stream(File &file, uint32_t offset, uint32_t length, uint32_t maxLines, Sink sink) // maxLines 0 = no limit
+    {
+        uint32_t size = file.size();
+        bytes = 0;
+        readUs = 0;
+        totalUs = 0;
+        if(offset >= size || !file.seek(offset))
+        {
+            return 0;
+        }
+        uint32_t end = (length > size - offset) ? size : offset + length;
+        uint32_t pos = offset;
+        uint32_t lines = 0;
+        int64_t start = esp_timer_get_time();
+
+        while(pos < end)
+        {
+            uint32_t want = BlockSize - (pos % BlockSize);                      // 1st read only: up to the next block boundary
+            if(want > end - pos)
+            {
+                want = end - pos;
+            }
+            int64_t readStart = esp_timer_get_time();
+            size_t got = file.read(block, want);
+            readUs += (uint32_t)(esp_timer_get_time() - readStart);
+            if(got == 0)
+            {
+                break;
+            }
+            pos += got;
+
+            if(maxLines > 0)                                                    // `head`: cut the block after the last wanted line
+            {
+                const uint8_t *scan = block;
+                const uint8_t *newline;
+                while(lines < maxLines && (newline = (const uint8_t *)memchr(scan, '\n', block + got - scan)) != NULL)
+                {
+                    lines++;
+                    scan = newline + 1;
+                }
+                if(lines == maxLines)
+                {
+                    got = scan - block;
+                    end = pos;                                                  // Done after this block
+                }
+            }
+            sink((const char *)block, got);
+            bytes += got;
+        }
+        totalUs = (uint32_t)(esp_timer_get_time() - start);
+        return bytes;
+    }
+
+    uint32_t tailOffset(File &file, uint32_t lines)                             // Where the last `lines` lines start
+    {
+        uint32_t size = file.size();
+        uint32_t pos = size;
+        uint32_t found = 0;
+        if(lines == 0)
+        {
+            return size;
+        }
+        while(pos > 0)
+        {
+            uint32_t blockStart = (pos - 1) / BlockSize * BlockSize;            // Aligned, like `stream()`
+            uint32_t len = pos - blockStart;
+            if(!file.seek(blockStart) || file.read(block, len) != len)
+            {
+                return 0;
+            }
+            for(uint32_t i = len; i-- > 0;)
+            {
+                if(block[i] == '\n' && blockStart + i != size - 1 && ++found == lines) // A final '\n' ends the last line
+                {
+                    return blockStart + i + 1;
+                }
+            }
+            pos = blockStart;
+        }
+        return 0;                                                               // Fewer lines than asked: the whole file
+    }
+
+    /*** Stats of the last `stream()` ***/
+
+    uint32_t lastBytes() const
+    {
+        return bytes;
+    }
+
+    uint32_t lastReadUs() const                                                 // Inside `file.read()` only
+    {
+        return readUs;
+    }
+
+    uint32_t lastTotalUs() const                                                // Reads + sink, e.g. waiting for the UART
+    {
+        return totalUs;
+    }
+
+private:
+    alignas(4) uint8_t block[BlockSize];                                        // Word aligned: SPI DMA takes it directly
+    uint32_t bytes = 0;
+    uint32_t readUs = 0;
+    uint32_t totalUs = 0;
+};
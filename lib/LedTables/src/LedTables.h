@@ -0,0 +1,113 @@
+/**
+ * Joel Brigida
+ * October 18, 2026
+ * LED lookup tables built by the compiler, so the render path is 1 array read per LED.
+ *     `LedTables::gamma12[level]`: 8-bit brightness -> 12-bit LEDC duty on the CIE 1931
+ *                                   lightness curve (perceptually even steps, 255 -> 4095).
+ *     `LedTables::wheel[hue]`:      8-bit hue -> full saturation & value RGB (spectrum wheel,
+ *                                   r + g + b = 255 for every hue, 0 = pure red).
+ * Both live in flash. The `static_assert`s below check the endpoints & that the gamma curve
+ * never goes down, so any compile (ESP32 or host) is the test.
+ * No Arduino dependencies: host tools can include this file too. C++11 compatible.
+ * Ref: https://en.wikipedia.org/wiki/CIELAB_color_space#From_CIELAB_to_CIEXYZ
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace LedTables
+{
+    enum { LEVELS = 256 };
+    enum { DUTY_MAX = 4095 };                                                   // 12-bit LEDC timer
+
+    struct Rgb
+    {
+        uint8_t r, g, b;
+    };
+
+    struct GammaTable
+    {
+        uint16_t duty[LEVELS];
+
+        constexpr uint16_t operator[](uint8_t level) const
+        {
+            return duty[level];
+        }
+    };
+
+    struct WheelTable
+    {
+        Rgb color[LEVELS];
+
+        constexpr Rgb operator[](uint8_t hue) const
+        {
+            return color[hue];
+        }
+    };
+
+    namespace detail                                                            // Compile time generators (C++11: 1 return each)
+    {
+        template <size_t... I> struct Indices {};
+        template <size_t N, size_t... I> struct MakeIndices : MakeIndices<N - 1, N - 1, I...> {};
+        template <size_t... I> struct MakeIndices<0, I...> { typedef Indices<I...> type; };
+
+        constexpr double cube(double x)
+        {
+            return x * x * x;
+        }
+
+        constexpr double lightnessToLuminance(double L)                         // CIE L* (0 - 100) -> relative luminance Y (0 - 1)
+        {
+            return (L <= 8.0) ? (L / 903.3) : cube((L + 16.0) / 116.0);
+        }
+
+        constexpr uint16_t gammaDuty(size_t level)
+        {
+            return (uint16_t)(lightnessToLuminance(level * 100.0 / (LEVELS - 1)) * DUTY_MAX + 0.5);
+        }
+
+        constexpr Rgb wheelSection(size_t section, uint8_t pos)                 // 3 sections: R->G, G->B, B->R
+        {
+            return (section == 0) ? Rgb{ (uint8_t)(255 - pos), pos, 0 } :
+                   (section == 1) ? Rgb{ 0, (uint8_t)(255 - pos), pos } :
+                                    Rgb{ pos, 0, (uint8_t)(255 - pos) };
+        }
+
+        constexpr Rgb wheelColor(size_t hue)
+        {
+            return wheelSection(hue * 3 / LEVELS, (uint8_t)(hue * 3 % LEVELS));
+        }
+
+        template <size_t... I>
+        constexpr GammaTable makeGamma(Indices<I...>)
+        {
+            return GammaTable{ { gammaDuty(I)... } };
+        }
+
+        template <size_t... I>
+        constexpr WheelTable makeWheel(Indices<I...>)
+        {
+            return WheelTable{ { wheelColor(I)... } };
+        }
+
+        constexpr bool neverFalls(const GammaTable &table, size_t i)
+        {
+            return (i + 1 >= LEVELS) || (table.duty[i] <= table.duty[i + 1] && neverFalls(table, i + 1));
+        }
+
+        constexpr bool constantSum(const WheelTable &table, size_t i)
+        {
+            return (i >= LEVELS) || (table.color[i].r + table.color[i].g + table.color[i].b == 255 && constantSum(table, i + 1));
+        }
+    }
+
+    constexpr GammaTable gamma12 = detail::makeGamma(detail::MakeIndices<LEVELS>::type());
+    constexpr WheelTable wheel = detail::makeWheel(detail::MakeIndices<LEVELS>::type());
+
+    static_assert(gamma12[0] == 0 && gamma12[LEVELS - 1] == DUTY_MAX, "gamma endpoints must be off & full on");
+    static_assert(detail::neverFalls(gamma12, 0), "gamma curve must be monotonic");
+    static_assert(wheel[0].r == 255 && wheel[0].g == 0 && wheel[0].b == 0, "hue 0 must be pure red");
+    static_assert(detail::constantSum(wheel, 0), "every hue must have the same total output");
+}
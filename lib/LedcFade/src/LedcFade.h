@@ -0,0 +1,102 @@
+/**
+ * Joel Brigida
+ * October 18, 2026
+ * Hardware fades on 1 LEDC channel: the peripheral ramps the duty by itself & the fade-end
+ * interrupt notifies 1 task, so a breathing LED costs 2 wakeups per cycle instead of 1 per
+ * software step. Call `begin()` after `ledcSetup()` from the task that will wait, then
+ * `fadeTo()` & sleep in `ulTaskNotifyTake()` until the ramp ends.
+ * The ramp is linear in duty (no gamma curve): hardware can't follow a lookup table.
+ * `begin()` returns false when hardware fades are unavailable, & every call is a no-op when
+ * built with `-D LEDC_HW_FADE=0` (host builds, other chips): callers fade in software then.
+ * Ref: https://docs.espressif.com/projects/esp-idf/en/v4.4/esp32/api-reference/peripherals/ledc.html#change-pwm-duty-cycle-using-hardware
+ * Usage:
+ *     static LedcFade fader;
+ *     if(fader.begin(LEDCchan)) { fader.fadeTo(4095, 1500); ulTaskNotifyTake(pdTRUE, portMAX_DELAY); }
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+#ifndef LEDC_HW_FADE
+#define LEDC_HW_FADE 1                                                          // 0 = software fallback only
+#endif
+
+#if LEDC_HW_FADE
+#include "driver/ledc.h"
+#endif
+
+class LedcFade
+{
+public:
+    bool begin(uint8_t channel)                                                 // Arduino LEDC channel #, after `ledcSetup()`
+    {
+#if LEDC_HW_FADE
+        mode = (ledc_mode_t)(channel / 8);                                      // Arduino: channels 0-7 = speed mode 0, 8-15 = 1
+        chan = (ledc_channel_t)(channel % 8);
+        task = xTaskGetCurrentTaskHandle();
+
+        ledc_fade_func_install(0);                                              // Fails harmlessly if already installed
+        ledc_cbs_t callbacks = { fadeEnd };
+        ready = (ledc_cb_register(mode, chan, &callbacks, this) == ESP_OK);
+#endif
+        return ready;
+    }
+
+    bool fadeTo(uint32_t duty, uint32_t ms)                                     // Ramp from the current duty, never blocks
+    {
+#if LEDC_HW_FADE
+        if(!ready || ledc_set_fade_with_time(mode, chan, duty, ms) != ESP_OK)
+        {
+            return false;
+        }
+        fading = true;
+        if(ledc_fade_start(mode, chan, LEDC_FADE_NO_WAIT) != ESP_OK)
+        {
+            fading = false;
+            return false;
+        }
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    bool available() const
+    {
+        return ready;
+    }
+
+    bool busy() const                                                           // A ramp is running right now
+    {
+        return fading;
+    }
+
+    uint32_t completed() const                                                  // Fade-end interrupts so far
+    {
+        return fadeCount;
+    }
+
+private:
+#if LEDC_HW_FADE
+    static bool IRAM_ATTR fadeEnd(const ledc_cb_param_t *param, void *arg)     // LEDC ISR: only wake the task
+    {
+        LedcFade *self = (LedcFade *)arg;
+        BaseType_t taskWoken = pdFALSE;
+        if(param->event == LEDC_FADE_END_EVT)
+        {
+            self->fading = false;
+            self->fadeCount++;
+            vTaskNotifyGiveFromISR(self->task, &taskWoken);
+        }
+        return taskWoken == pdTRUE;                                             // true = yield when the ISR returns
+    }
+
+    ledc_mode_t mode;
+    ledc_channel_t chan;
+    TaskHandle_t task = NULL;
+#endif
+    bool ready = false;
+    volatile bool fading = false;
+    volatile uint32_t fadeCount = 0;
+};
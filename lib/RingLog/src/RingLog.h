@@ -0,0 +1,261 @@
+/**
+ * Joel Brigida
+ * October 18, 2026
+ * Log with a fixed disk footprint: `segments` preallocated `AppendLog` files of `segmentBytes`
+ * each, written round-robin. When a line doesn't fit the current segment, the next one (the
+ * oldest) is emptied in place & becomes current, so the card never fills & no cluster is ever
+ * allocated after the 1st pass. A tiny index file in the same directory records the current
+ * segment, the rotation count & the final length of every segment, so reopening after a
+ * reboot or power loss needs no directory scan & `usedBytes()` needs no walk of the FAT.
+ * Files: `<dir>/index`, `<dir>/seg00.alog` ... Index (little-endian uint32): "RLOG", version (1),
+ * segments, segment bytes, current, rotations, length per segment, check
+ * Usage:
+ *     static RingLog<4096, 16> log;
+ *     log.open(SD, "/log", 8, 128 * 1024);                    // 8 x 128kB: ~1MB on the card, ever
+ *     log.append(line, len);                                  // Rotates by itself
+ *     log.poll();                                             // As for `AppendLog`
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include "FS.h"
+#include "AppendLog.h"
+
+template <size_t BufSize = 4096, size_t MaxSegments = 16>
+class RingLog
+{
+    static_assert(MaxSegments >= 2 && MaxSegments <= 64, "2 - 64 segments: the index stays 1 sector");
+
+public:
+    enum { VERSION = 1 };
+    enum : uint32_t { NEVER = AppendLog<BufSize>::NEVER };                      // `msUntilSync()`: nothing buffered
+    enum { INDEX_WORDS = 7 + MaxSegments };                                     // Header words + 1 length per segment
+
+    bool open(fs::FS &sd, const char *directory, uint8_t segmentCount, uint32_t segmentBytes, uint32_t flushMs = 1000)
+    {
+        close();
+        card = &sd;
+        interval = flushMs;
+        snprintf(dir, sizeof(dir), "%s", directory);
+        snprintf(indexPath, sizeof(indexPath), "%s/index", dir);
+        card->mkdir(dir);                                                       // Fails harmlessly if it exists
+        segmentCount = (segmentCount < 2) ? 2 : (segmentCount > MaxSegments) ? MaxSegments : segmentCount; // As stored: compared to the index
+
+        if(!readIndex() || count != segmentCount || size != segmentBytes)       // New, broken or resized: start over at 0
+        {
+            count = segmentCount;
+            size = segmentBytes;
+            current = 0;
+            rotationCount = 0;
+            memset(lengths, 0, sizeof(lengths));
+            if(!openSegment(current) || !log.truncate() || !writeIndex())
+            {
+                return false;
+            }
+            return true;
+        }
+        return openSegment(current);                                            // `AppendLog` recovers its own length
+    }
+
+    bool append(const char *data, size_t len)                                   // false: longer than a segment, or card error
+    {
+        if(!log.isOpen() || len > size)
+        {
+            droppedCount++;
+            return false;
+        }
+        if(log.size() + len > size && !rotate())
+        {
+            droppedCount++;
+            return false;
+        }
+        return log.append(data, len);
+    }
+
+    bool rotate()                                                               // Close the current segment, empty & use the oldest
+    {
+        log.close();                                                            // Syncs: its final length is in its header
+        lengths[current] = log.size();
+        uint8_t next = (current + 1) % count;
+        if(!openSegment(next) || !log.truncate())                               // Empty before the index points at it
+        {
+            return false;
+        }
+        lengths[next] = 0;
+        current = next;
+        rotationCount++;
+        return writeIndex();
+    }
+
+    bool sync()
+    {
+        return log.sync();
+    }
+
+    uint32_t msUntilSync()
+    {
+        return log.msUntilSync();
+    }
+
+    void poll()
+    {
+        log.poll();
+    }
+
+    void close()
+    {
+        log.close();
+    }
+
+    bool isOpen()
+    {
+        return log.isOpen();
+    }
+
+    /*** Segments: 0 = current, 1 = the one before... ***/
+
+    uint8_t segmentBack(uint32_t back) const                                    // Index of the segment `back` rotations ago
+    {
+        return (current + count - (back % count)) % count;
+    }
+
+    uint32_t segmentsUsed() const                                               // Segments with data: all after the 1st wrap
+    {
+        return (rotationCount + 1 < count) ? rotationCount + 1 : count;
+    }
+
+    uint32_t segmentLength(uint8_t segment) const
+    {
+        return (segment == current) ? log.size() : lengths[segment];
+    }
+
+    void segmentPath(uint8_t segment, char *path, size_t len) const
+    {
+        snprintf(path, len, "%s/seg%02u.alog", dir, segment);
+    }
+
+    /*** Usage & Stats: from the index, no FAT access ***/
+
+    uint64_t usedBytes() const                                                  // Log data in all segments
+    {
+        uint64_t used = 0;
+        for(uint8_t i = 0; i < count; i++)
+        {
+            used += segmentLength(i);
+        }
+        return used;
+    }
+
+    uint64_t footprintBytes() const                                             // On the card, whatever the log holds
+    {
+        return (uint64_t)count * (AppendLog<BufSize>::HEADER_SIZE + size) + INDEX_WORDS * 4;
+    }
+
+    uint8_t segments() const
+    {
+        return count;
+    }
+
+    uint32_t segmentSize() const
+    {
+        return size;
+    }
+
+    uint8_t currentSegment() const
+    {
+        return current;
+    }
+
+    uint32_t rotations() const
+    {
+        return rotationCount;
+    }
+
+    uint32_t dropped() const
+    {
+        return droppedCount;
+    }
+
+    const AppendLog<BufSize> &segmentLog() const                                // Current segment: appends, writes, syncs
+    {
+        return log;
+    }
+
+private:
+    bool openSegment(uint8_t segment)                                           // Preallocates it on the 1st pass & after a resize
+    {
+        char path[sizeof(dir) + 16];
+        segmentPath(segment, path, sizeof(path));
+        return log.open(*card, path, size, interval);
+    }
+
+    bool readIndex()
+    {
+        uint32_t words[INDEX_WORDS];
+        File file = card->open(indexPath, FILE_READ);
+        bool ok = file && file.read((uint8_t *)words, sizeof(words)) == sizeof(words);
+        file.close();
+        if(!ok || words[0] != MAGIC || words[1] != VERSION || words[2] < 2 || words[2] > MaxSegments ||
+           words[4] >= words[2] || words[INDEX_WORDS - 1] != checksum(words))
+        {
+            return false;
+        }
+        count = words[2];
+        size = words[3];
+        current = words[4];
+        rotationCount = words[5];
+        memcpy(lengths, words + 6, sizeof(lengths));
+        return true;
+    }
+
+    bool writeIndex()                                                           // Rewritten in place: 1 sector, no FAT change
+    {
+        uint32_t words[INDEX_WORDS];
+        words[0] = MAGIC;
+        words[1] = VERSION;
+        words[2] = count;
+        words[3] = size;
+        words[4] = current;
+        words[5] = rotationCount;
+        memcpy(words + 6, lengths, sizeof(lengths));
+        words[INDEX_WORDS - 1] = checksum(words);
+
+        File file = card->open(indexPath, "r+");
+        if(!file)
+        {
+            file = card->open(indexPath, FILE_WRITE);                           // 1st time only
+        }
+        bool ok = file && file.seek(0) && file.write((const uint8_t *)words, sizeof(words)) == sizeof(words);
+        if(ok)
+        {
+            file.flush();
+        }
+        file.close();
+        return ok;
+    }
+
+    static uint32_t checksum(const uint32_t *words)
+    {
+        uint32_t check = MAGIC;
+        for(int i = 0; i < INDEX_WORDS - 1; i++)
+        {
+            check ^= words[i] * (i + 1);                                        // Position matters: swapped words don't pass
+        }
+        return check;
+    }
+
+    static const uint32_t MAGIC = 0x474F4C52;                                   // "RLOG", little-endian
+
+    AppendLog<BufSize> log;                                                     // The current segment
+    fs::FS *card = NULL;
+    char dir[32] = "";
+    char indexPath[40] = "";
+    uint8_t count = 0;
+    uint8_t current = 0;
+    uint32_t size = 0;
+    uint32_t interval = 1000;
+    uint32_t rotationCount = 0;
+    uint32_t lengths[MaxSegments] = {};                                         // Final length of every closed segment
+    uint32_t droppedCount = 0;
+};
@@ -0,0 +1,313 @@
+/**
+ * Joel Brigida
+ * October 18, 2026
+ * SD card I/O benchmark for picking logger buffer sizes. For every block size from 512 B to
+ * 32 kB (powers of 2) it times each single operation of 4 tests:
+ *     seq-write:    a `fileBytes` file written front to back (the close, which syncs, is in MB/s)
+ *     seq-read:     the same file read back front to back
+ *     rand-read:    block-aligned reads at random offsets in it (block 4096 = random 4 kB reads)
+ *     append-flush: write + `flush()` to a file open for append, like a logger that must not lose lines
+ * Then 64 B log lines 2 ways, per line latency & MB/s (block column = line length):
+ *     line-reopen:  open for append, write, close per line, like `appendFile` in 04 / 05
+ *     line-alog:    `lib/AppendLog`: preallocated, stays open, 4kB RAM buffer, synced every 1s & at the end
+ * Results: MB/s & per-operation latency (~p50 / ~p99 from power of 2 buckets, exact max), printed
+ * as a table & written to `<dir>/sdbench.csv`. The test files are removed afterwards.
+ * Only uses the Arduino `fs::FS` / `File` API, so `tools/sd_bench.cpp` runs the same code on
+ * a PC (e.g. against a card in a USB reader) with the stand-ins in `tools/host`.
+ * Usage:
+ *     uint8_t *buffer = (uint8_t *)malloc(SDBench::MAX_BLOCK);
+ *     SDBench bench(SD, "/bench");
+ *     bench.run(1024 * 1024, buffer, serialOut);              // Any `out` with printf()
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include "FS.h"
+#include "AppendLog.h"
+
+class SDBench
+{
+public:
+    enum { MIN_BLOCK = 512, MAX_BLOCK = 32768, NUM_BLOCKS = 7 };                // Block sizes: 512 << 0 ... 512 << 6
+    enum Test { SEQ_WRITE, SEQ_READ, RAND_READ, APPEND_FLUSH, NUM_TESTS };      // Swept over the block sizes
+    enum LineTest { LINE_REOPEN = NUM_TESTS, LINE_ALOG, NUM_LINE_TESTS = 2 };   // Once, after the sweep
+    enum { RANDOM_OPS = 256, APPEND_OPS = 64 };                                 // Capped by the file size / block
+    enum { LINE_LEN = 64, LINES = 500 };
+    enum { NUM_BUCKETS = 24 };                                                  // Bucket n: < 2^(n+1) us
+
+    struct Row
+    {
+        uint8_t test;                                                           // Test
+        uint32_t block;
+        uint32_t ops;                                                           // Operations that completed
+        uint64_t bytes;
+        uint32_t us;                                                            // Whole test, incl. open & close
+        uint32_t p50;                                                           // Per operation, us
+        uint32_t p99;
+        uint32_t max;
+        bool ok;                                                                // false: open failed or a short read / write
+    };
+
+    SDBench(fs::FS &card, const char *directory)
+        : fs(card)
+    {
+        snprintf(dir, sizeof(dir), "%s", directory);
+        snprintf(dataPath, sizeof(dataPath), "%s/seq.bin", dir);
+        snprintf(appendPath, sizeof(appendPath), "%s/append.bin", dir);
+        snprintf(csvPath, sizeof(csvPath), "%s/sdbench.csv", dir);
+        snprintf(logPath, sizeof(logPath), "%s/lines.alog", dir);
+    }
+
+    template <class Out>
+    bool run(uint32_t fileBytes, uint8_t *buffer, Out &out)                     // `buffer`: MAX_BLOCK bytes. false = some test failed
+    {
+        fileBytes = (fileBytes < (uint32_t)MAX_BLOCK) ? (uint32_t)MAX_BLOCK : fileBytes / MAX_BLOCK * MAX_BLOCK; // Whole blocks at every size
+        for(uint32_t i = 0; i < MAX_BLOCK; i++)
+        {
+            buffer[i] = (uint8_t)(i * 7 + (i >> 8));                            // Not all 0s or 1s: some cards shortcut those
+        }
+        fs.mkdir(dir);                                                          // Fails harmlessly if it exists
+
+        bool ok = true;
+        count = 0;
+        out.printf("\nSD Benchmark: %ukB file, %d random reads, %d appends per block size\n", fileBytes / 1024,
+                   RANDOM_OPS, APPEND_OPS);
+        out.printf("%-13s %6s %6s %9s %9s %9s %9s\n", "test", "block", "ops", "MB/s", "~p50 us", "~p99 us", "max us");
+        for(int n = 0; n < NUM_BLOCKS; n++)
+        {
+            uint32_t block = MIN_BLOCK << n;
+            for(int test = 0; test < NUM_TESTS; test++)
+            {
+                Row &row = rows[count++];
+                runTest((Test)test, block, fileBytes, buffer, row);
+                ok = ok && row.ok;
+                printRow(row, out);
+            }
+        }
+        for(int test = LINE_REOPEN; test < LINE_REOPEN + NUM_LINE_TESTS; test++)
+        {
+            Row &row = rows[count++];
+            runLines((LineTest)test, buffer, row);
+            ok = ok && row.ok;
+            printRow(row, out);
+        }
+        out.printf("(line-alog preallocated %ukB in %ums once, not in its MB/s)\n", LINES * LINE_LEN / 1024,
+                   preallocUs / 1000);
+        fs.remove(dataPath);
+        fs.remove(appendPath);
+        fs.remove(logPath);
+
+        if(writeCsv())
+        {
+            out.printf("Results written to %s\n\n", csvPath);
+        }
+        else
+        {
+            out.printf("Could not write %s\n\n", csvPath);
+        }
+        return ok;
+    }
+
+    size_t size() const
+    {
+        return count;
+    }
+
+    const Row &row(size_t i) const
+    {
+        return rows[i];
+    }
+
+    static const char *testName(uint8_t test)
+    {
+        static const char *names[NUM_TESTS + NUM_LINE_TESTS] = { "seq-write", "seq-read", "rand-read", "append-flush",
+                                                                 "line-reopen", "line-alog" };
+        return (test < NUM_TESTS + NUM_LINE_TESTS) ? names[test] : "?";
+    }
+
+private:
+    struct Histogram
+    {
+        uint32_t count;
+        uint32_t max;
+        uint32_t buckets[NUM_BUCKETS];
+
+        void add(uint32_t us)
+        {
+            count++;
+            if(us > max)
+            {
+                max = us;
+            }
+            int b = (us < 2) ? 0 : (31 - __builtin_clz(us));                    // floor(log2(us))
+            buckets[(b < NUM_BUCKETS) ? b : (NUM_BUCKETS - 1)]++;
+        }
+
+        uint32_t percentile(uint32_t pct) const                                 // Upper edge of the bucket holding it
+        {
+            uint32_t target = (count * pct + 99) / 100;
+            uint32_t seen = 0;
+            for(int b = 0; b < NUM_BUCKETS; b++)
+            {
+                seen += buckets[b];
+                if(count > 0 && seen >= target)
+                {
+                    return 2UL << b;
+                }
+            }
+            return 0;
+        }
+    };
+
+    void runTest(Test test, uint32_t block, uint32_t fileBytes, uint8_t *buffer, Row &row)
+    {
+        Histogram hist = {};
+        uint32_t blocks = fileBytes / block;
+        uint32_t ops = (test == RAND_READ) ? min(blocks, (uint32_t)RANDOM_OPS) :
+                       (test == APPEND_FLUSH) ? min(blocks, (uint32_t)APPEND_OPS) : blocks;
+        uint32_t seed = 12345;                                                  // Same offsets on every run & card
+        row = Row{ (uint8_t)test, block, 0, 0, 0, 0, 0, 0, false };
+
+        if(test == APPEND_FLUSH)
+        {
+            fs.remove(appendPath);                                              // Every block size starts from an empty file
+        }
+        int64_t start = esp_timer_get_time();
+        File file = fs.open((test == APPEND_FLUSH) ? appendPath : dataPath,
+                            (test == SEQ_WRITE) ? FILE_WRITE : (test == APPEND_FLUSH) ? FILE_APPEND : FILE_READ);
+        if(!file)
+        {
+            return;
+        }
+        for(uint32_t op = 0; op < ops; op++)
+        {
+            int64_t opStart = esp_timer_get_time();
+            size_t done = 0;
+            if(test == SEQ_WRITE)
+            {
+                done = file.write(buffer, block);
+            }
+            else if(test == SEQ_READ)
+            {
+                done = file.read(buffer, block);
+            }
+            else if(test == RAND_READ)
+            {
+                seed = seed * 1103515245 + 12345;                               // LCG: no libc `rand()` state shared with others
+                done = file.seek((seed >> 8) % blocks * block) ? file.read(buffer, block) : 0;
+            }
+            else if(test == APPEND_FLUSH)
+            {
+                done = file.write(buffer, block);
+                file.flush();                                                   // Data & FAT entry on the card
+            }
+            hist.add((uint32_t)(esp_timer_get_time() - opStart));
+            if(done != block)
+            {
+                file.close();
+                return;
+            }
+            row.ops++;
+            row.bytes += block;
+        }
+        file.close();
+        row.us = (uint32_t)(esp_timer_get_time() - start);
+        row.p50 = min(hist.percentile(50), hist.max);                           // A bucket's edge can be past the slowest op
+        row.p99 = min(hist.percentile(99), hist.max);
+        row.max = hist.max;
+        row.ok = true;
+    }
+
+    void runLines(LineTest test, uint8_t *buffer, Row &row)                     // 64 B lines: reopen per line vs `AppendLog`
+    {
+        Histogram hist = {};
+        AppendLog<4096> *log = NULL;
+        row = Row{ (uint8_t)test, LINE_LEN, 0, 0, 0, 0, 0, 0, false };
+        memset(buffer, 'x', LINE_LEN);
+        buffer[LINE_LEN - 1] = '\n';
+        fs.remove(logPath);
+
+        if(test == LINE_ALOG)
+        {
+            log = new AppendLog<4096>();                                        // 4kB buffer: only while it runs
+            if(!log->open(fs, logPath, LINES * LINE_LEN))
+            {
+                delete log;
+                return;
+            }
+            preallocUs = log->preallocateUs();
+        }
+        int64_t start = esp_timer_get_time();
+        bool ok = true;
+        for(uint32_t line = 0; ok && line < LINES; line++)
+        {
+            int64_t opStart = esp_timer_get_time();
+            if(test == LINE_REOPEN)
+            {
+                File file = fs.open(logPath, FILE_APPEND);
+                ok = file && file.write(buffer, LINE_LEN) == LINE_LEN;
+                file.close();
+            }
+            else
+            {
+                ok = log->append((const char *)buffer, LINE_LEN);
+                log->poll();                                                    // Time flush, as a logger task would
+            }
+            hist.add((uint32_t)(esp_timer_get_time() - opStart));
+            row.ops += ok;
+        }
+        if(log != NULL)
+        {
+            ok = ok && log->sync();                                             // Everything on the card, like the reopen run
+            log->close();
+            delete log;
+        }
+        row.us = (uint32_t)(esp_timer_get_time() - start);
+        row.bytes = (uint64_t)row.ops * LINE_LEN;
+        row.p50 = min(hist.percentile(50), hist.max);
+        row.p99 = min(hist.percentile(99), hist.max);
+        row.max = hist.max;
+        row.ok = ok;
+    }
+
+    template <class Out>
+    void printRow(const Row &row, Out &out)
+    {
+        uint32_t kBps = row.us ? (uint32_t)(row.bytes * 1000000 / 1024 / row.us) : 0;
+        out.printf("%-13s %6u %6u %5u.%03u %9u %9u %9u%s\n", testName(row.test), row.block, row.ops, kBps / 1024,
+                   (kBps % 1024) * 1000 / 1024, row.p50, row.p99, row.max, row.ok ? "" : "  FAILED");
+    }
+
+    bool writeCsv()
+    {
+        File file = fs.open(csvPath, FILE_WRITE);
+        if(!file)
+        {
+            return false;
+        }
+        char line[96];
+        int len = snprintf(line, sizeof(line), "test,block,ops,bytes,us,kB_per_s,p50_us,p99_us,max_us,ok\n");
+        file.write((const uint8_t *)line, len);
+        for(size_t i = 0; i < count; i++)
+        {
+            const Row &r = rows[i];
+            len = snprintf(line, sizeof(line), "%s,%u,%u,%llu,%u,%u,%u,%u,%u,%d\n", testName(r.test), r.block, r.ops,
+                           (unsigned long long)r.bytes, r.us, r.us ? (uint32_t)(r.bytes * 1000000 / 1024 / r.us) : 0,
+                           r.p50, r.p99, r.max, r.ok ? 1 : 0);
+            file.write((const uint8_t *)line, len);
+        }
+        file.close();
+        return true;
+    }
+
+    fs::FS &fs;
+    char dir[32];
+    char dataPath[48];
+    char appendPath[48];
+    char csvPath[48];
+    char logPath[48];
+    Row rows[NUM_BLOCKS * NUM_TESTS + NUM_LINE_TESTS];
+    uint32_t preallocUs = 0;
+    size_t count = 0;
+};
@@ -0,0 +1,62 @@
+/**
+ * Joel Brigida
+ * October 18, 2026
+ * Latest-value mailbox for a small struct (sequence lock).
+ * Writers edit the value in place under a spinlock, so the newest write always wins &
+ * nothing ever queues up behind it. Readers never block: they copy the struct & retry if
+ * a write overlapped the copy (sequence was odd or changed). Every write bumps `version()`,
+ * so a reader can check 1 word per frame & only take a snapshot when something changed.
+ * Usage:
+ *     static SeqLock<LedParams> ledParams(defaults);
+ *     ledParams.update([](LedParams &p) { p.delayMs = 20; });         // Any task, either core
+ *     if(ledParams.version() != seen) { seen = ledParams.read(snapshot); } // Render loop
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+
+template <typename T>
+class SeqLock
+{
+public:
+    explicit SeqLock(const T &initial) : value(initial) {}
+
+    template <typename Fn>
+    uint32_t update(Fn edit)                                                    // `edit(T &)` runs with interrupts masked: keep it tiny
+    {
+        portENTER_CRITICAL(&writeLock);                                         // Writers on either core take turns
+        uint32_t seq = sequence.load(std::memory_order_relaxed);
+        sequence.store(seq + 1, std::memory_order_relaxed);                     // Odd: write in progress
+        std::atomic_thread_fence(std::memory_order_release);
+        edit(value);
+        sequence.store(seq + 2, std::memory_order_release);                     // Even: value is consistent again
+        portEXIT_CRITICAL(&writeLock);
+        return (seq + 2) / 2;
+    }
+
+    uint32_t read(T &snapshot) const                                            // Returns the version of `snapshot`
+    {
+        uint32_t before;
+        uint32_t after;
+        do
+        {
+            before = sequence.load(std::memory_order_acquire);
+            memcpy(&snapshot, &value, sizeof(T));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = sequence.load(std::memory_order_relaxed);
+        } while((before & 1) || before != after);                               // Torn copy: try again
+        return before / 2;
+    }
+
+    uint32_t version() const                                                    // # of writes so far
+    {
+        return sequence.load(std::memory_order_acquire) / 2;
+    }
+
+private:
+    T value;
+    std::atomic<uint32_t> sequence{0};
+    portMUX_TYPE writeLock = portMUX_INITIALIZER_UNLOCKED;
+};
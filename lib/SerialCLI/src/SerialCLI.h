@@ -0,0 +1,456 @@
+/**
+ * Joel Brigida
+ * October 18, 2026
+ * Line-based serial command interpreter shared by the CLI projects.
+ * `SerialCLI` owns line assembly, echo & dispatch: a project only registers its commands.
+ * Sizes are template parameters, so the line buffer & command table are part of the object
+ * & nothing is allocated at runtime. Commands match by prefix, like the `memcmp()` checks
+ * they replace: register "delay " (with the space) to get the text after it as `args`.
+ * Lines that match no command go to the default handler, if one is set. Empty lines are
+ * ignored & over-long lines are rejected as a whole instead of being dispatched truncated.
+ * `Out` is anything with `print(const char *)` & `write(const char *, size_t)`: `Print`
+ * (e.g. `Serial`) or `SerialOut`.
+ *
+ * Line editing (ANSI/VT100 terminal: `pio device monitor`, PuTTY, screen):
+ *     Backspace, Delete, Left/Right, Home/End (also Ctrl-A/Ctrl-E), Ctrl-U clears the line.
+ *     Up/Down recall history when `HistoryBytes` > 0. Past entries are stored back to back
+ *     as NULL terminated strings in a ring arena of `HistoryBytes`, so short commands cost
+ *     only their length + 1 & the oldest entries are overwritten when it fills up.
+ * Every keystroke sends only what changed on screen: the chars right of the cursor, a cursor
+ * move (`\b` when shorter than `ESC[nD`) & `ESC[K` when a recalled line is shorter.
+ *
+ * Usage:
+ *     static SerialCLI<64, 4> cli;                                // 64 char lines, 4 commands
+ *     cli.add("delay ", setDelay);                                // void setDelay(const char *args)
+ *     cli.begin(Serial, Serial);
+ *     for(;;) { cli.poll(); vTaskDelay(20 / portTICK_PERIOD_MS); } // In the CLI task
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+template <size_t LineLen = 80, size_t MaxCommands = 8, class Out = Print, size_t HistoryBytes = 0>
+class SerialCLI
+{
+    static_assert(LineLen >= 2, "need room for at least 1 char + NULL");
+    static_assert((HistoryBytes & (HistoryBytes - 1)) == 0, "HistoryBytes must be 0 or a power of 2");
+
+public:
+    typedef void (*Handler)(const char *args);                                  // Text after the matched prefix
+
+    bool add(const char *prefix, Handler handler)                               // false if the table is full
+    {
+        if(numCommands >= MaxCommands)
+        {
+            return false;
+        }
+        commands[numCommands].prefix = prefix;
+        commands[numCommands].len = strlen(prefix);
+        commands[numCommands].handler = handler;
+        numCommands++;
+        return true;
+    }
+
+    void setDefault(Handler handler)                                            // Gets the whole line when nothing matches
+    {
+        fallback = handler;
+    }
+
+    void setEcho(bool on)
+    {
+        echo = on;
+    }
+
+    void begin(Stream &inPort, Out &outPort)
+    {
+        in = &inPort;
+        out = &outPort;
+    }
+
+    size_t poll()                                                               // Drain all received bytes, returns # read
+    {
+        size_t count = 0;
+        while(in->available() > 0)
+        {
+            feed((char)in->read());
+            count++;
+        }
+        return count;
+    }
+
+    bool feed(char input)                                                       // Returns true when a line was dispatched
+    {
+        bool ran = key(input);
+        flush();                                                                // 1 write per keystroke
+        return ran;
+    }
+
+    bool dispatch(const char *line)                                             // Run 1 complete line (e.g. from a script)
+    {
+        for(size_t i = 0; i < numCommands; i++)
+        {
+            if(strncmp(line, commands[i].prefix, commands[i].len) == 0)         // 1st registered match wins
+            {
+                commands[i].handler(line + commands[i].len);
+                return true;
+            }
+        }
+        if(fallback != NULL)
+        {
+            fallback(line);
+            return true;
+        }
+        return false;
+    }
+
+private:
+    enum EscState : uint8_t { ESC_NONE, ESC_START, ESC_CSI };                   // ESC, ESC [ or ESC O
+
+    bool key(char input)
+    {
+        if(escState != ESC_NONE)
+        {
+            escape(input);
+            return false;
+        }
+        if(input == '\n' && lastInput == '\r')                                  // CR LF counts as 1 ENTER
+        {
+            lastInput = input;
+            return false;
+        }
+        lastInput = input;
+
+        if(input == '\r' || input == '\n')
+        {
+            return enter();
+        }
+        else if(input == '\b' || input == 0x7F)                                 // Most terminals send DEL for Backspace
+        {
+            backspace();
+        }
+        else if(input == 0x1B)
+        {
+            escState = ESC_START;
+            escParam = 0;
+        }
+        else if(input == 0x01)                                                  // Ctrl-A
+        {
+            moveTo(0);
+        }
+        else if(input == 0x05)                                                  // Ctrl-E
+        {
+            moveTo(len);
+        }
+        else if(input == 0x15)                                                  // Ctrl-U
+        {
+            replaceLine("");
+        }
+        else if((uint8_t)input >= 0x20)                                         // Other control chars are ignored
+        {
+            insert(input);
+        }
+        return false;
+    }
+
+    void escape(char input)
+    {
+        if(escState == ESC_START)
+        {
+            escState = (input == '[' || input == 'O') ? ESC_CSI : ESC_NONE;
+            return;
+        }
+        if(input >= '0' && input <= '9')
+        {
+            escParam = (uint8_t)(escParam * 10 + (input - '0'));
+            return;
+        }
+        escState = ESC_NONE;
+
+        if(input == 'A')                                                        // Up: older
+        {
+            recall(histPos + 1);
+        }
+        else if(input == 'B')                                                   // Down: newer, then back to empty
+        {
+            recall(histPos - 1);
+        }
+        else if(input == 'C')                                                   // Right
+        {
+            moveTo(cursor + 1);
+        }
+        else if(input == 'D')                                                   // Left
+        {
+            moveTo(cursor - 1);
+        }
+        else if(input == 'H' || (input == '~' && (escParam == 1 || escParam == 7))) // Home: ESC [ H or ESC [ 1 ~
+        {
+            moveTo(0);
+        }
+        else if(input == 'F' || (input == '~' && (escParam == 4 || escParam == 8))) // End: ESC [ F or ESC [ 4 ~
+        {
+            moveTo(len);
+        }
+        else if(input == '~' && escParam == 3)                                  // Delete: ESC [ 3 ~
+        {
+            del();
+        }
+    }
+
+    bool enter()
+    {
+        emit('\n');
+        flush();
+        bool tooLong = overflow;
+        buffer[len] = '\0';
+        size_t lineLen = len;
+        len = 0;
+        cursor = 0;
+        histPos = 0;
+        overflow = false;
+
+        if(tooLong)
+        {
+            out->print("ERROR: Line Too Long, Ignored\n");
+            return false;
+        }
+        if(lineLen == 0)
+        {
+            return false;
+        }
+        remember(buffer, lineLen);
+        return dispatch(buffer);
+    }
+
+    void insert(char c)
+    {
+        if(len >= LineLen - 1)
+        {
+            overflow = true;                                                    // Rejected at ENTER unless edited down
+            emit('\a');
+            return;
+        }
+        memmove(buffer + cursor + 1, buffer + cursor, len - cursor);
+        buffer[cursor] = c;
+        len++;
+        emit(buffer + cursor, len - cursor);                                    // Just `c` when typing at the end
+        cursor++;
+        left(len - cursor);
+    }
+
+    void backspace()
+    {
+        if(cursor == 0)
+        {
+            return;
+        }
+        cursor--;
+        emit('\b');
+        del();
+    }
+
+    void del()                                                                  // Delete the char under the cursor
+    {
+        if(cursor == len)
+        {
+            return;
+        }
+        memmove(buffer + cursor, buffer + cursor + 1, len - cursor - 1);
+        len--;
+        overflow = false;                                                       // The user saw the line was full
+        emit(buffer + cursor, len - cursor);                                    // Shift the tail left 1 column
+        emit(' ');
+        left(len - cursor + 1);
+    }
+
+    void moveTo(size_t pos)                                                     // `pos` may have wrapped below 0
+    {
+        if(pos > len)
+        {
+            return;
+        }
+        if(pos < cursor)
+        {
+            left(cursor - pos);
+        }
+        else if(pos > cursor)
+        {
+            right(pos - cursor);
+        }
+        cursor = pos;
+    }
+
+    void replaceLine(const char *line)                                          // Rewrite only from the 1st changed column
+    {
+        size_t newLen = strlen(line);
+        size_t same = 0;
+        while(same < len && same < newLen && buffer[same] == line[same])
+        {
+            same++;
+        }
+        moveTo(same);
+        emit(line + same, newLen - same);
+        if(newLen < len)
+        {
+            emit("\x1b[K", 3);                                                  // Clear what's left of the old line
+        }
+        memcpy(buffer + same, line + same, newLen - same);
+        len = cursor = newLen;
+        overflow = false;
+    }
+
+    void left(size_t n)
+    {
+        if(n < 4)
+        {
+            while(n-- > 0)
+            {
+                emit('\b');                                                     // 1 byte vs. 4 for `ESC[1D`
+            }
+            return;
+        }
+        char seq[12];
+        int seqLen = snprintf(seq, sizeof(seq), "\x1b[%uD", (unsigned)n);
+        emit(seq, seqLen);
+    }
+
+    void right(size_t n)
+    {
+        if(n < 4)
+        {
+            emit(buffer + cursor, n);                                           // Reprinting is shorter than `ESC[nC`
+            return;
+        }
+        char seq[12];
+        int seqLen = snprintf(seq, sizeof(seq), "\x1b[%uC", (unsigned)n);
+        emit(seq, seqLen);
+    }
+
+    /*** History arena: [entry\0][entry\0]... between `histTail` & `histHead` (free running) ***/
+
+    void remember(const char *line, size_t lineLen)
+    {
+        if(HistoryBytes == 0 || lineLen + 1 > HistoryBytes)
+        {
+            return;
+        }
+        if(entry(1) && strcmp(scratch, line) == 0)                              // Don't store repeats back to back
+        {
+            return;
+        }
+        while(HistoryBytes - (histHead - histTail) < lineLen + 1)               // Drop whole entries, oldest 1st
+        {
+            while(hist[histTail++ % HistSize] != '\0') {}
+        }
+        for(size_t i = 0; i <= lineLen; i++)
+        {
+            hist[histHead++ % HistSize] = line[i];
+        }
+    }
+
+    bool entry(size_t n)                                                        // Copy entry n into `scratch`, 1 = newest
+    {
+        uint32_t end = histHead;
+        for(size_t i = 1; end != histTail; i++)
+        {
+            uint32_t start = end - 1;                                           // This entry's NULL
+            while(start != histTail && hist[(start - 1) % HistSize] != '\0')
+            {
+                start--;
+            }
+            if(i == n)
+            {
+                size_t j = 0;
+                while(j < LineLen - 1 && (scratch[j] = hist[(start + j) % HistSize]) != '\0')
+                {
+                    j++;
+                }
+                scratch[j] = '\0';
+                return true;
+            }
+            end = start;
+        }
+        return false;
+    }
+
+    void recall(size_t n)                                                       // 0 = empty line below the newest
+    {
+        if(HistoryBytes == 0 || n == (size_t)-1)
+        {
+            return;
+        }
+        if(n == 0)
+        {
+            scratch[0] = '\0';
+        }
+        else if(!entry(n))
+        {
+            return;                                                             // Already at the oldest entry
+        }
+        histPos = n;
+        replaceLine(scratch);
+    }
+
+    /*** Output: 1 write per keystroke, only while echo is on ***/
+
+    void emit(char c)
+    {
+        emit(&c, 1);
+    }
+
+    void emit(const char *data, size_t n)
+    {
+        if(!echo)
+        {
+            return;
+        }
+        if(outLen + n > sizeof(outBuf))
+        {
+            flush();
+        }
+        memcpy(outBuf + outLen, data, n);                                       // `outBuf` always fits 1 whole line
+        outLen += n;
+    }
+
+    void flush()
+    {
+        if(outLen > 0)
+        {
+            out->write(outBuf, outLen);
+            outLen = 0;
+        }
+    }
+
+    struct Entry
+    {
+        const char *prefix;
+        size_t len;
+        Handler handler;
+    };
+
+    Entry commands[MaxCommands > 0 ? MaxCommands : 1];                          // 0 commands = default handler only
+    size_t numCommands = 0;
+    Handler fallback = NULL;
+
+    char buffer[LineLen];
+    size_t len = 0;                                                             // Chars in `buffer`, never counts '\n'
+    size_t cursor = 0;                                                          // Edit position, 0..len
+    bool overflow = false;
+    char lastInput = 0;
+    bool echo = true;
+    EscState escState = ESC_NONE;
+    uint8_t escParam = 0;
+
+    enum { HistSize = HistoryBytes > 0 ? HistoryBytes : 1 };
+    char hist[HistSize];
+    char scratch[HistoryBytes > 0 ? LineLen : 1];                               // Recalled line, off the task stack
+    uint32_t histHead = 0;
+    uint32_t histTail = 0;
+    size_t histPos = 0;                                                         // 0 = editing a new line
+
+    char outBuf[LineLen + 16];                                                  // Whole line + 1 cursor move / clear
+    size_t outLen = 0;
+
+    Stream *in = NULL;
+    Out *out = NULL;
+};
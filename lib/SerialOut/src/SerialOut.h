@@ -0,0 +1,147 @@
+/**
+ * Joel Brigida
+ * October 18, 2026
+ * Buffered, non-blocking serial output. Any task on either core formats into its own
+ * stack & drops the bytes into a lock-free `TxRing`. A single output task is the only
+ * code that ever touches the UART, so a slow terminal only stalls that task.
+ * If the ring is full, the write is dropped & counted (see `dropped()`). Bulk dumps
+ * (file contents etc.) that must not lose data use `writeWait()`, which only blocks its caller.
+ * `setMuted(true)` silences the text helpers (print/println/printf) while raw binary
+ * `write()` calls still go out, e.g. while the CLI speaks a binary protocol.
+ * Usage:
+ *     static SerialOut<64, 32> serialOut;                     // 64 slots * 32 bytes = 2kB ring
+ *     serialOut.begin(Serial, app_cpu);                       // Start the output task in setup()
+ *     serialOut.printf("New Delay Value: %dms\n", ms);        // From any task
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include "TxRing.h"
+
+template <size_t SlotCount = 64, size_t SlotSize = 32>
+class SerialOut
+{
+public:
+    enum { FMT_BUF_LEN = 128 };                                                 // Max length of 1 printf() message
+    enum { CHUNK_LEN = 256 };                                                   // Bytes handed to the UART at once
+
+    void begin(Print &port, BaseType_t core, UBaseType_t priority = 1)
+    {
+        out = &port;
+        xTaskCreatePinnedToCore(
+            outputTask,
+            "Serial Output",
+            2048,
+            (void *)this,
+            priority,
+            &outTask,
+            core
+        );
+    }
+
+    bool write(const char *data, size_t len)
+    {
+        bool ok = ring.write(data, len);
+        if(ok && outTask != NULL)
+        {
+            xTaskNotifyGive(outTask);                                           // Wake the output task (never blocks)
+        }
+        return ok;
+    }
+
+    void writeWait(const char *data, size_t len)                                // Bulk dumps only: retries until there is room
+    {
+        while(len > 0)
+        {
+            size_t chunk = (len > SlotSize) ? SlotSize : len;
+            while(!ring.write(data, chunk, false))
+            {
+                vTaskDelay(1);                                                  // Let the output task drain the ring
+            }
+            if(outTask != NULL)
+            {
+                xTaskNotifyGive(outTask);
+            }
+            data += chunk;
+            len -= chunk;
+        }
+    }
+
+    void setMuted(bool mute)                                                    // Muted: print* are dropped, write* still go out
+    {
+        muted = mute;
+    }
+
+    bool print(const char *str)
+    {
+        return muted || write(str, strlen(str));
+    }
+
+    bool print(char c)
+    {
+        return muted || write(&c, 1);
+    }
+
+    bool println(const char *str = "")
+    {
+        if(muted)
+        {
+            return true;
+        }
+        char buffer[FMT_BUF_LEN];
+        int len = snprintf(buffer, FMT_BUF_LEN, "%s\n", str);
+        return write(buffer, clampLen(len));
+    }
+
+    __attribute__((format(printf, 2, 3)))
+    bool printf(const char *format, ...)
+    {
+        if(muted)
+        {
+            return true;
+        }
+        char buffer[FMT_BUF_LEN];
+        va_list args;
+        va_start(args, format);
+        int len = vsnprintf(buffer, FMT_BUF_LEN, format, args);
+        va_end(args);
+        return write(buffer, clampLen(len));
+    }
+
+    uint32_t dropped() const
+    {
+        return ring.dropped();
+    }
+
+private:
+    static size_t clampLen(int len)
+    {
+        if(len < 0)
+        {
+            return 0;
+        }
+        return ((size_t)len >= FMT_BUF_LEN) ? (FMT_BUF_LEN - 1) : (size_t)len; // Truncated messages still go out
+    }
+
+    static void outputTask(void *param)
+    {
+        SerialOut *self = (SerialOut *)param;
+        char chunk[CHUNK_LEN];
+        size_t len;
+
+        for(;;)
+        {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);                            // Sleep until a producer writes
+            while((len = self->ring.read(chunk, CHUNK_LEN)) > 0)
+            {
+                self->out->write((const uint8_t *)chunk, len);                  // Only this task blocks on the UART
+            }
+        }
+    }
+
+    TxRing<SlotCount, SlotSize> ring;
+    Print *out = NULL;
+    TaskHandle_t outTask = NULL;
+    volatile bool muted = false;                                                // e.g. while the CLI speaks binary frames
+};
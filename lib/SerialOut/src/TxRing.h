@@ -0,0 +1,135 @@
+/**
+ * Joel Brigida
+ * October 18, 2026
+ * Lock-free multi-producer / single-consumer byte ring for serial output.
+ * The ring is an array of fixed-size slots, each with its own sequence number
+ * (bounded MPMC queue by D. Vyukov, reduced to a single consumer). A producer
+ * reserves every slot its message needs with one compare-and-swap on `enqueuePos`,
+ * so messages from different tasks are never interleaved. If the ring is full the
+ * message is dropped & counted instead of waiting: producers never block.
+ * Only uses <atomic>, so it is safe from any task on either core & builds on a host PC.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <atomic>
+
+template <size_t SlotCount, size_t SlotSize = 32>
+class TxRing
+{
+    static_assert((SlotCount & (SlotCount - 1)) == 0, "SlotCount must be a power of 2");
+    static_assert(SlotSize > 0 && SlotSize <= 255, "SlotSize must fit in a uint8_t");
+
+public:
+    TxRing()
+    {
+        for(uint32_t i = 0; i < SlotCount; i++)
+        {
+            slots[i].seq.store(i, std::memory_order_relaxed);                 // Slot `i` is free for position `i`
+        }
+        enqueuePos.store(0, std::memory_order_relaxed);
+        droppedWrites.store(0, std::memory_order_relaxed);
+        dequeuePos = 0;
+    }
+
+    bool write(const char *data, size_t len, bool countDrop = true)             // Producer side: any task, any core
+    {
+        if(len == 0)
+        {
+            return true;
+        }
+
+        uint32_t need = (len + SlotSize - 1) / SlotSize;                        // # of slots for this message
+        if(need > SlotCount)
+        {
+            droppedWrites.fetch_add(1, std::memory_order_relaxed);              // Can never fit, always counted
+            return false;
+        }
+
+        uint32_t pos = enqueuePos.load(std::memory_order_relaxed);
+        for(;;)
+        {
+            Slot &last = slots[(pos + need - 1) & MASK];                        // Slots are released in order, so if the
+            uint32_t seq = last.seq.load(std::memory_order_acquire);            // last one is free then all of them are
+            int32_t diff = (int32_t)(seq - (pos + need - 1));
+
+            if(diff == 0)
+            {
+                if(enqueuePos.compare_exchange_weak(pos, pos + need, std::memory_order_relaxed))
+                {
+                    break;                                                      // Slots [pos, pos + need) are ours
+                }
+            }
+            else if(diff < 0 && enqueuePos.load(std::memory_order_relaxed) == pos)
+            {
+                if(countDrop)
+                {
+                    droppedWrites.fetch_add(1, std::memory_order_relaxed);      // Ring is full: drop, never wait
+                }
+                return false;
+            }
+            else
+            {
+                pos = enqueuePos.load(std::memory_order_relaxed);               // Lost the race: try again
+            }
+        }
+
+        for(uint32_t i = 0; i < need; i++)                                      // Fill & publish each slot
+        {
+            Slot &slot = slots[(pos + i) & MASK];
+            size_t chunk = (len > SlotSize) ? SlotSize : len;
+            memcpy(slot.data, data, chunk);
+            slot.len = (uint8_t)chunk;
+            slot.seq.store(pos + i + 1, std::memory_order_release);
+            data += chunk;
+            len -= chunk;
+        }
+        return true;
+    }
+
+    size_t read(char *out, size_t maxLen)                                       // Consumer side: 1 task only
+    {
+        size_t count = 0;
+
+        for(;;)
+        {
+            Slot &slot = slots[dequeuePos & MASK];
+            if(slot.seq.load(std::memory_order_acquire) != dequeuePos + 1)
+            {
+                break;                                                          // Empty, or producer still copying
+            }
+            if(count + slot.len > maxLen)
+            {
+                break;                                                          // Caller's buffer is full
+            }
+            memcpy(out + count, slot.data, slot.len);
+            count += slot.len;
+            slot.seq.store(dequeuePos + SlotCount, std::memory_order_release);  // Free slot for the next lap
+            dequeuePos++;
+        }
+        return count;
+    }
+
+    uint32_t dropped() const
+    {
+        return droppedWrites.load(std::memory_order_relaxed);
+    }
+
+private:
+    static const uint32_t MASK = SlotCount - 1;
+
+    struct Slot
+    {
+        std::atomic<uint32_t> seq;                                              // == position + 1 when it holds data
+        uint8_t len;
+        char data[SlotSize];
+    };
+
+    Slot slots[SlotCount];
+    std::atomic<uint32_t> enqueuePos;                                           // Next position handed to a producer
+    std::atomic<uint32_t> droppedWrites;                                        // Messages lost to a full ring
+    uint32_t dequeuePos;                                                        // Owned by the consumer task
+};
@@ -0,0 +1,111 @@
+/**
+ * Joel Brigida
+ * October 18, 2026
+ * Block 1 task on several event sources at once: any # of queues, serial RX & a shutdown
+ * signal. Built on a FreeRTOS queue set, so a task that used to poll its queues with a 0
+ * timeout & then sleep now wakes exactly when something arrives & never otherwise.
+ * Serial RX uses `HardwareSerial::onReceive()`, which gives a binary semaphore that is a
+ * member of the set. Queues must be empty when `begin()` adds them, so call it in `setup()`
+ * before the tasks that write to them start.
+ * After `wait()` returns `EV_QUEUE`, read exactly 1 item from `queue` with a 0 timeout.
+ * Ref: https://www.freertos.org/RTOS-queue-sets.html
+ * Usage:
+ *     static WaitSet<1> events;
+ *     events.addQueue(msgQueue, MSG_QUEUE_LEN);
+ *     events.addSerial(Serial);
+ *     events.begin();                                         // In setup()
+ *     if(events.wait(queue) == events.EV_SERIAL) { cli.poll(); } // In the task
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+template <size_t MaxQueues = 2>
+class WaitSet
+{
+public:
+    enum Event { EV_TIMEOUT, EV_QUEUE, EV_SERIAL, EV_SHUTDOWN };
+
+    bool addQueue(QueueHandle_t queue, UBaseType_t length)                      // Before `begin()`: length it was created with
+    {
+        if(numQueues >= MaxQueues || set != NULL)
+        {
+            return false;
+        }
+        queues[numQueues] = queue;
+        lengths[numQueues] = length;
+        numQueues++;
+        return true;
+    }
+
+    void addSerial(HardwareSerial &port)                                        // Before `begin()`, after `port.begin()`
+    {
+        rxReady = xSemaphoreCreateBinary();
+        port.onReceive([this]() { xSemaphoreGive(rxReady); });                  // Runs in the UART event task, not an ISR
+    }
+
+    bool begin()
+    {
+        UBaseType_t setLength = 1;                                              // `stop` semaphore
+        for(size_t i = 0; i < numQueues; i++)
+        {
+            setLength += lengths[i];                                            // 1 set event per queued item
+        }
+        if(rxReady != NULL)
+        {
+            setLength += 1;
+        }
+
+        stop = xSemaphoreCreateBinary();
+        set = xQueueCreateSet(setLength);
+        if(set == NULL || stop == NULL)
+        {
+            return false;
+        }
+        for(size_t i = 0; i < numQueues; i++)
+        {
+            xQueueAddToSet(queues[i], set);
+        }
+        if(rxReady != NULL)
+        {
+            xQueueAddToSet(rxReady, set);
+        }
+        xQueueAddToSet(stop, set);
+        return true;
+    }
+
+    Event wait(QueueHandle_t &queue, TickType_t timeout = portMAX_DELAY)       // `queue` is set for EV_QUEUE only
+    {
+        QueueSetMemberHandle_t member = xQueueSelectFromSet(set, timeout);
+        if(member == NULL)
+        {
+            return EV_TIMEOUT;
+        }
+        if(member == rxReady)
+        {
+            xSemaphoreTake(rxReady, 0);                                         // Bytes that arrive later give it again
+            return EV_SERIAL;
+        }
+        if(member == stop)
+        {
+            xSemaphoreTake(stop, 0);
+            return EV_SHUTDOWN;
+        }
+        queue = (QueueHandle_t)member;
+        return EV_QUEUE;
+    }
+
+    void shutdown()                                                             // From any task: wakes the waiting task with EV_SHUTDOWN
+    {
+        xSemaphoreGive(stop);
+    }
+
+private:
+    QueueHandle_t queues[MaxQueues > 0 ? MaxQueues : 1];                        // WaitSet<0>: serial RX & shutdown only
+    UBaseType_t lengths[MaxQueues > 0 ? MaxQueues : 1];
+    size_t numQueues = 0;
+    SemaphoreHandle_t rxReady = NULL;
+    SemaphoreHandle_t stop = NULL;
+    QueueSetHandle_t set = NULL;
+};
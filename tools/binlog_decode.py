@@ -0,0 +1,140 @@
+#!/usr/bin/env python3
+"""
+Decodes a BinLog stream (see lib/BinLog/src/BinLog.h) back into text.
+
+Record layout: SYNC(0xB1), arg length, core, ID (u32), CPU cycles (u32), raw args.
+Bytes outside of records (plain `Serial.print` text) are passed through unchanged.
+
+Usage:
+    python tools/binlog_decode.py binlog_dict.json --port /dev/ttyUSB0      # live (needs pyserial)
+    python tools/binlog_decode.py binlog_dict.json --file capture.bin       # saved capture
+"""
+
+import argparse
+import json
+import re
+import struct
+import sys
+
+SYNC = 0xB1
+HEADER_LEN = 11
+MAX_ARG_BYTES = 48
+
+SPEC = re.compile(r"%([-+ #0]*\d*(?:\.\d+)?)(hh|h|ll|l|z|j|t)?([diuxXoceEfFgGsp%])")
+
+
+def render(fmt, args):
+    """Walks the conversion specifiers in `fmt` & pulls each argument out of `args`."""
+    out = []
+    pos = 0
+    last = 0
+    for m in SPEC.finditer(fmt):
+        out.append(fmt[last:m.start()])
+        last = m.end()
+        flags, length, conv = m.groups()
+        try:
+            if conv == "%":
+                out.append("%")
+            elif conv == "s":
+                n = args[pos]
+                if len(args) < pos + 1 + n:
+                    raise IndexError
+                out.append(("%" + flags + "s") % args[pos + 1:pos + 1 + n].decode("utf-8", "replace"))
+                pos += 1 + n
+            elif conv in "eEfFgG":
+                (value,) = struct.unpack_from("<f", args, pos)
+                out.append(("%" + flags + conv) % value)
+                pos += 4
+            else:
+                size = 8 if length == "ll" else 4
+                signed = conv in "di"
+                if len(args) < pos + size:
+                    raise IndexError
+                value = int.from_bytes(args[pos:pos + size], "little", signed=signed)
+                if conv == "c":
+                    out.append(chr(value & 0xFF))
+                elif conv == "p":
+                    out.append("0x%08x" % value)
+                else:
+                    out.append(("%" + flags + conv) % value)
+                pos += size
+        except (IndexError, struct.error):
+            out.append("<truncated>")
+            break
+    out.append(fmt[last:])
+    return "".join(out)
+
+
+class Decoder:
+    def __init__(self, formats, mhz):
+        self.formats = formats
+        self.cycles_per_ms = mhz * 1000.0
+        self.buf = bytearray()
+        self.last = {}                                              # core -> (last raw count, unwrapped count)
+
+    def unwrap(self, core, cycles):
+        prev_raw, total = self.last.get(core, (cycles, 0))
+        total += (cycles - prev_raw) & 0xFFFFFFFF                   # 32-bit counter wraps every ~18s at 240MHz
+        self.last[core] = (cycles, total)
+        return total
+
+    def feed(self, data):
+        self.buf += data
+        text = bytearray()
+        out = []
+        while self.buf:
+            if self.buf[0] != SYNC:
+                text.append(self.buf.pop(0))
+                continue
+            if len(self.buf) < HEADER_LEN:
+                break                                               # Wait for the rest of the header
+            length, core = self.buf[1], self.buf[2]
+            key = "%08x" % struct.unpack_from("<I", self.buf, 3)[0]
+            if length > MAX_ARG_BYTES or core > 1 or key not in self.formats:
+                text.append(self.buf.pop(0))                        # Not a record: resync on the next byte
+                continue
+            if len(self.buf) < HEADER_LEN + length:
+                break
+            (cycles,) = struct.unpack_from("<I", self.buf, 7)
+            args = bytes(self.buf[HEADER_LEN:HEADER_LEN + length])
+            del self.buf[:HEADER_LEN + length]
+            if text:
+                out.append(text.decode("utf-8", "replace"))
+                text = bytearray()
+            stamp = self.unwrap(core, cycles) / self.cycles_per_ms
+            out.append("[%u %10.3fms] %s" % (core, stamp, render(self.formats[key], args)))
+        if text:
+            out.append(text.decode("utf-8", "replace"))
+        return "".join(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("dictionary", help="JSON file written by binlog_dict.py")
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument("--port", help="serial port to read live")
+    source.add_argument("--file", help="binary capture to decode")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--mhz", type=float, default=240.0, help="CPU frequency for cycle -> ms conversion")
+    args = parser.parse_args()
+
+    with open(args.dictionary, encoding="utf-8") as f:
+        decoder = Decoder(json.load(f), args.mhz)
+
+    if args.file:
+        with open(args.file, "rb") as f:
+            sys.stdout.write(decoder.feed(f.read()))
+        return
+
+    import serial                                                   # pip install pyserial
+    with serial.Serial(args.port, args.baud, timeout=0.1) as port:
+        try:
+            while True:
+                sys.stdout.write(decoder.feed(port.read(4096)))
+                sys.stdout.flush()
+        except KeyboardInterrupt:
+            pass
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,90 @@
+#!/usr/bin/env python3
+"""
+Builds the BinLog dictionary (format string ID -> format string) for a project.
+
+Scans C/C++ sources for `BLOG("...")` calls & hashes each format string with the
+same FNV-1a hash that `BinLog::hash()` evaluates at compile time, so the IDs in the
+binary stream can be mapped back to their format strings by `binlog_decode.py`.
+
+Usage:
+    python tools/binlog_dict.py Intro-To-RTOS/10c-dining-philosophers-hierarchy/src -o binlog_dict.json
+"""
+
+import argparse
+import json
+import os
+import re
+import sys
+
+SOURCE_EXT = (".c", ".cpp", ".h", ".hpp", ".ino")
+
+BLOG_CALL = re.compile(r'\bBLOG\s*\(\s*((?:"(?:[^"\\]|\\.)*"\s*)+)')
+STRING_LITERAL = re.compile(r'"((?:[^"\\]|\\.)*)"')
+ESCAPES = {"n": "\n", "t": "\t", "r": "\r", "0": "\0", "\\": "\\", '"': '"', "'": "'", "a": "\a", "b": "\b", "f": "\f", "v": "\v"}
+
+
+def unescape(literal):
+    """Converts the body of a C string literal into the bytes the compiler stores."""
+    out = bytearray()
+    i = 0
+    while i < len(literal):
+        ch = literal[i]
+        if ch != "\\":
+            out += ch.encode("utf-8")
+            i += 1
+            continue
+        nxt = literal[i + 1]
+        if nxt == "x":
+            m = re.match(r"[0-9a-fA-F]+", literal[i + 2:])
+            out.append(int(m.group(0), 16) & 0xFF)
+            i += 2 + len(m.group(0))
+        elif nxt in "01234567" and re.match(r"[0-7]{2,3}", literal[i + 1:]):
+            m = re.match(r"[0-7]{1,3}", literal[i + 1:])
+            out.append(int(m.group(0), 8) & 0xFF)
+            i += 1 + len(m.group(0))
+        else:
+            out += ESCAPES.get(nxt, nxt).encode("utf-8")
+            i += 2
+    return bytes(out)
+
+
+def fnv1a(data):
+    h = 2166136261
+    for b in data:
+        h = ((h ^ b) * 16777619) & 0xFFFFFFFF
+    return h
+
+
+def scan(paths):
+    formats = {}
+    for root in paths:
+        files = [root] if os.path.isfile(root) else [
+            os.path.join(d, f) for d, _, names in os.walk(root) for f in names if f.endswith(SOURCE_EXT)
+        ]
+        for path in sorted(files):
+            with open(path, encoding="utf-8", errors="replace") as src:
+                text = src.read()
+            for call in BLOG_CALL.finditer(text):
+                fmt = b"".join(unescape(s) for s in STRING_LITERAL.findall(call.group(1)))
+                key = "%08x" % fnv1a(fmt)
+                decoded = fmt.decode("utf-8", errors="replace")
+                if key in formats and formats[key] != decoded:
+                    sys.exit("ERROR: hash collision between %r and %r" % (formats[key], decoded))
+                formats[key] = decoded
+    return formats
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("paths", nargs="+", help="source files or folders to scan")
+    parser.add_argument("-o", "--output", default="binlog_dict.json", help="dictionary file to write")
+    args = parser.parse_args()
+
+    formats = scan(args.paths)
+    with open(args.output, "w", encoding="utf-8") as out:
+        json.dump(formats, out, indent=2, sort_keys=True)
+    print("%d format strings -> %s" % (len(formats), args.output))
+
+
+if __name__ == "__main__":
+    main()
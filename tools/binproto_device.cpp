@@ -0,0 +1,94 @@
+/**
+ * Joel Brigida
+ * October 18, 2026
+ * Host echo device for the binary CLI protocol of 04-CLI-LEDs, built from the firmware's own
+ * `BinProtocol.cpp` (COBS, CRC16, `FrameReader`, `buildFrame()`, `argValue()`), so
+ * `tools/cli_client.py --loopback` tests the Python framing against the C++ one instead of
+ * against itself. Frames arrive on stdin & responses leave on stdout, byte for byte as on
+ * the UART. Every good frame is answered with status OK & a payload of
+ *     [opcode][argValue() as 4 bytes LE]    or, for OP_TEXT (0x20):    [opcode][text]
+ * so the client can check the argument encoding too. Bad frames get no response, like the
+ * firmware. BinProtocol has no Arduino dependencies: no `tools/host` stand-ins are needed.
+ * Build & run from the repo root:
+ *     g++ -O2 -std=gnu++11 -Wall -IMy-RTOS-Projects/04-CLI-LEDs/src tools/binproto_device.cpp \
+ *         My-RTOS-Projects/04-CLI-LEDs/src/BinProtocol.cpp -o binproto_device
+ *     python tools/cli_client.py --loopback ./binproto_device selftest     # every opcode & arg size, bad frames
+ *     python tools/cli_client.py --loopback ./binproto_device bench 5000   # pipelined pings through the pipes
+ * Prints the frame counts to stderr at EOF.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include "BinProtocol.h"
+
+static const uint8_t OP_TEXT = 0x20;                                            // Same as `CmdOp` in 04 main.cpp
+
+static bool writeAll(const uint8_t *data, size_t len)
+{
+    while(len > 0)
+    {
+        ssize_t done = write(STDOUT_FILENO, data, len);
+        if(done <= 0)
+        {
+            return false;
+        }
+        data += done;
+        len -= done;
+    }
+    return true;
+}
+
+int main()
+{
+    BinProtocol::FrameReader reader;
+    BinProtocol::Frame request;
+    BinProtocol::Frame response;
+    uint8_t input[256];
+    uint8_t encoded[BinProtocol::MAX_ENCODED];
+    uint32_t good = 0;
+    uint32_t bad = 0;
+    ssize_t got;
+
+    while((got = read(STDIN_FILENO, input, sizeof(input))) > 0)
+    {
+        for(ssize_t i = 0; i < got; i++)
+        {
+            int result = reader.push(input[i], request);
+            if(result < 0)
+            {
+                bad++;                                                          // Dropped: the host sees no response
+                continue;
+            }
+            if(result == 0)
+            {
+                continue;
+            }
+            good++;
+            response.seq = request.seq;
+            response.code = 0x00;                                               // ST_OK
+            response.payload[0] = request.code;
+            if(request.code == OP_TEXT)
+            {
+                size_t len = (request.len < BinProtocol::MAX_PAYLOAD) ? request.len : BinProtocol::MAX_PAYLOAD - 1;
+                memcpy(response.payload + 1, request.payload, len);
+                response.len = 1 + len;
+            }
+            else
+            {
+                int32_t arg = BinProtocol::argValue(request);
+                for(int b = 0; b < 4; b++)
+                {
+                    response.payload[1 + b] = (uint8_t)((uint32_t)arg >> (8 * b));
+                }
+                response.len = 5;
+            }
+            if(!writeAll(encoded, BinProtocol::buildFrame(response, encoded)))
+            {
+                return 1;
+            }
+        }
+    }
+    fprintf(stderr, "binproto_device: %u good frames, %u bad frames\n", good, bad);
+    return 0;
+}
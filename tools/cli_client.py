@@ -0,0 +1,297 @@
+#!/usr/bin/env python3
+"""
+Host client for the 04-CLI-LEDs binary protocol (see My-RTOS-Projects/04-CLI-LEDs/src/BinProtocol.h).
+
+Frames are COBS encoded & 0x00 terminated:
+    request:  [seq][opcode][arg: 0/1/2/4 bytes signed LE][CRC16 LE]
+    response: [seq][status][payload][CRC16 LE]
+Requests are pipelined: up to `window` frames are in flight, responses are matched by seq.
+
+Usage:
+    python tools/cli_client.py --port /dev/ttyUSB0 fade 10        # 1 command, waits for its response
+    python tools/cli_client.py --port /dev/ttyUSB0 bench 5000     # pipelined pings: commands per second
+    python tools/cli_client.py --loopback ./binproto_device selftest     # client framing vs the firmware's
+    python tools/cli_client.py --loopback ./binproto_device bench 5000   # pipelined pings through pipes, no UART
+
+--loopback runs tools/binproto_device.cpp (built from the firmware's BinProtocol.cpp, see its header)
+over pipes, so COBS / CRC / argument encoding mismatches between the two sides show up on a PC.
+
+As a library:
+    with CliClient.open("/dev/ttyUSB0") as cli:
+        cli.command(OP_DELAY, 20)
+"""
+
+import argparse
+import os
+import struct
+import subprocess
+import sys
+import time
+from collections import deque
+
+OP_PING, OP_FADE, OP_DELAY, OP_PATTERN, OP_BRIGHT, OP_CPU, OP_VALUES, OP_FREQ = 0x01, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16
+OP_XFADE, OP_BENCH = 0x17, 0x18
+OP_TEXT, OP_TEXTMODE = 0x20, 0x21
+OPCODES = {"ping": OP_PING, "fade": OP_FADE, "delay": OP_DELAY, "pattern": OP_PATTERN, "bright": OP_BRIGHT,
+           "cpu": OP_CPU, "values": OP_VALUES, "freq": OP_FREQ, "xfade": OP_XFADE, "blendbench": OP_BENCH,
+           "text": OP_TEXT, "textmode": OP_TEXTMODE}
+STATUS = {0x00: "OK", 0x01: "BAD_OP", 0x02: "BAD_ARG", 0x03: "BUSY"}
+
+
+def crc16(data):
+    """CRC-16/CCITT-FALSE: poly 0x1021, init 0xFFFF."""
+    crc = 0xFFFF
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) & 0xFFFF if crc & 0x8000 else (crc << 1) & 0xFFFF
+    return crc
+
+
+def cobs_encode(data):
+    out = bytearray([0])
+    code_index, code = 0, 1
+    for b in data:
+        if b == 0:
+            out[code_index] = code
+            code_index, code = len(out), 1
+            out.append(0)
+        else:
+            out.append(b)
+            code += 1
+            if code == 0xFF:
+                out[code_index] = code
+                code_index, code = len(out), 1
+                out.append(0)
+    out[code_index] = code
+    return bytes(out)
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data):
+            return None
+        out += data[i + 1:i + code]
+        i += code
+        if code != 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def encode_arg(value):
+    """Smallest signed little-endian encoding, matching BinProtocol::argValue()."""
+    if value is None:
+        return b""
+    for size, fmt in ((1, "<b"), (2, "<h"), (4, "<i")):
+        try:
+            return struct.pack(fmt, value)
+        except struct.error:
+            continue
+    raise ValueError("argument out of int32 range: %d" % value)
+
+
+def build_frame(seq, code, payload=b""):
+    raw = bytes([seq & 0xFF, code]) + payload
+    raw += struct.pack("<H", crc16(raw))
+    return cobs_encode(raw) + b"\x00"
+
+
+def parse_frame(encoded):
+    raw = cobs_decode(encoded)
+    if raw is None or len(raw) < 4 or struct.unpack_from("<H", raw, len(raw) - 2)[0] != crc16(raw[:-2]):
+        return None                                                 # Stray text or a damaged frame
+    return raw[0], raw[1], raw[2:-2]
+
+
+class CliClient:
+    def __init__(self, link, window=16, timeout=1.0):
+        self.link = link                                            # Anything with read(n) / write(bytes)
+        self.window = window
+        self.timeout = timeout
+        self.seq = 0
+        self.rx = bytearray()
+
+    @classmethod
+    def open(cls, port, baud=115200, **kwargs):
+        import serial                                               # pip install pyserial
+        link = serial.Serial(port, baud, timeout=0.01)
+        link.write(b"binmode\n")                                    # Text command that switches the device
+        time.sleep(0.2)
+        link.reset_input_buffer()
+        return cls(link, **kwargs)
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc):
+        self.command(OP_TEXTMODE)
+        self.link.close()
+
+    def send(self, code, arg=None, payload=None):
+        seq = self.seq
+        self.seq = (self.seq + 1) & 0xFF
+        self.link.write(build_frame(seq, code, payload if payload is not None else encode_arg(arg)))
+        return seq
+
+    def responses(self):
+        """Yields every complete (seq, status, payload) received so far."""
+        self.rx += self.link.read(4096)
+        while b"\x00" in self.rx:
+            frame, _, rest = bytes(self.rx).partition(b"\x00")
+            self.rx = bytearray(rest)
+            if frame:
+                parsed = parse_frame(frame)
+                if parsed is not None:
+                    yield parsed
+
+    def command(self, code, arg=None, payload=None):
+        seq = self.send(code, arg, payload)
+        deadline = time.monotonic() + self.timeout
+        while time.monotonic() < deadline:
+            for rseq, status, data in self.responses():
+                if rseq == seq:
+                    return status, data
+        raise TimeoutError("no response for seq %d" % seq)
+
+    def pipeline(self, requests):
+        """Sends (code, arg) pairs keeping `window` in flight. Returns (responses, lost)."""
+        pending = deque()
+        results = []
+        todo = deque(requests)
+        deadline = time.monotonic() + self.timeout
+        while todo or pending:
+            while todo and len(pending) < self.window:
+                code, arg = todo.popleft()
+                pending.append(self.send(code, arg))
+            progressed = False
+            for rseq, status, data in self.responses():
+                if rseq in pending:
+                    while pending and pending[0] != rseq:           # Anything older was lost on the wire
+                        pending.popleft()
+                    pending.popleft()
+                    results.append((rseq, status, data))
+                    progressed = True
+            if progressed:
+                deadline = time.monotonic() + self.timeout
+            elif time.monotonic() > deadline:
+                break
+        return results, len(requests) - len(results)
+
+
+class LoopbackDevice:
+    """Link to tools/binproto_device: the firmware's framing code in a host process, over pipes."""
+
+    def __init__(self, path):
+        self.proc = subprocess.Popen([path], stdin=subprocess.PIPE, stdout=subprocess.PIPE, bufsize=0)
+        os.set_blocking(self.proc.stdout.fileno(), False)
+
+    def write(self, data):
+        self.proc.stdin.write(data)
+
+    def read(self, n):
+        try:
+            data = os.read(self.proc.stdout.fileno(), n)
+        except BlockingIOError:
+            data = b""
+        if not data:
+            time.sleep(0.0001)
+        return data
+
+    def close(self):
+        self.proc.stdin.close()
+        self.proc.wait()
+
+
+def selftest(client):
+    """Round-trips every opcode & argument size, text & damaged frames through binproto_device."""
+    failures = []
+    for name, code in sorted(OPCODES.items()):
+        if code == OP_TEXT:
+            continue
+        for arg in (None, 0, 1, -1, 127, -128, 128, -129, 32767, -32768, 32768, -32769, 2**31 - 1, -2**31):
+            status, data = client.command(code, arg)
+            if status != 0x00 or data != bytes([code]) + struct.pack("<i", arg or 0):
+                failures.append("%s %s -> %s %s" % (name, arg, STATUS.get(status, status), data.hex()))
+
+    for text in (b"", b"fade 10", bytes(range(79)), b"\x00" * 79, b"\xff" * 79):
+        status, data = client.command(OP_TEXT, payload=text)
+        if status != 0x00 or data != bytes([OP_TEXT]) + text:
+            failures.append("text %s -> %s" % (text[:8].hex(), data.hex()))
+
+    bad_seq = (client.seq + 128) & 0xFF                             # A response with this seq = a bad frame got in
+    raw = bytes([bad_seq, OP_PING])
+    crc = struct.pack("<H", crc16(raw) ^ 0x0001)
+    damaged = [cobs_encode(raw + crc) + b"\x00",                    # CRC off by 1 bit
+               b"hello\n\x00",                                      # Stray text ended by a delimiter
+               build_frame(bad_seq, OP_FADE, encode_arg(5))[:-3] + b"\x00",
+               b"\x01" * 200 + b"\x00"]                             # Longer than MAX_ENCODED
+    for frame in damaged:
+        client.link.write(frame)
+    seq = client.send(OP_PING)
+    deadline = time.monotonic() + client.timeout
+    answered = False
+    while not answered and time.monotonic() < deadline:
+        for rseq, status, data in client.responses():
+            if rseq == seq:
+                answered = True
+            else:
+                failures.append("damaged frame answered (seq %d)" % rseq)
+    if not answered:
+        failures.append("no response to the ping after the damaged frames")
+
+    for line in failures:
+        print("FAIL", line)
+    print("selftest: %d failures" % len(failures))
+    return not failures
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    link = parser.add_mutually_exclusive_group(required=True)
+    link.add_argument("--port", help="serial port of the ESP32")
+    link.add_argument("--loopback", metavar="DEVICE", help="path of a built tools/binproto_device (no hardware)")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--window", type=int, default=16, help="frames in flight while pipelining")
+    parser.add_argument("command", help="bench, selftest (--loopback), or an opcode name: " + ", ".join(sorted(OPCODES)))
+    parser.add_argument("value", nargs="?", help="argument (bench: number of pings)")
+    args = parser.parse_args()
+
+    if args.loopback:
+        client = CliClient(LoopbackDevice(args.loopback), window=args.window)
+    else:
+        client = CliClient.open(args.port, args.baud, window=args.window)
+
+    try:
+        if args.command == "bench":
+            count = int(args.value or 1000)
+            start = time.monotonic()
+            results, lost = client.pipeline([(OP_PING, None)] * count)
+            elapsed = time.monotonic() - start
+            print("%d commands in %.3fs = %.0f commands/s (%d lost)" % (len(results), elapsed, len(results) / elapsed, lost))
+            sys.exit(0 if lost == 0 else 1)
+        if args.command == "selftest":
+            if not args.loopback:
+                parser.error("selftest needs --loopback: the firmware doesn't echo arguments")
+            sys.exit(0 if selftest(client) else 1)
+
+        code = OPCODES[args.command]
+        if code == OP_TEXT:
+            status, data = client.command(code, payload=(args.value or "").encode())
+        else:
+            status, data = client.command(code, int(args.value) if args.value is not None else None)
+        print(STATUS.get(status, "0x%02x" % status), end="")
+        if code == OP_FREQ and len(data) == 12:
+            print(": CPU %d MHz, XTAL %d MHz, APB %d MHz" % struct.unpack("<3i", data), end="")
+        print()
+    finally:
+        if args.loopback:
+            client.link.close()
+        else:
+            client.__exit__(None, None, None)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,67 @@
+/**
+ * Joel Brigida
+ * October 18, 2026
+ * Host stand-in for the parts of Arduino-ESP32 & FreeRTOS that the LED render code uses, so
+ * `tools/led_render_bench.cpp` can build it with g++ on a PC. Tasks & notifications are
+ * no-ops (everything runs on 1 thread), LEDC writes are remembered so `ledcRead()` works.
+ * Not a simulator: only enough to render frames into memory.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include <type_traits>
+
+#define IRAM_ATTR
+#define PI 3.1415926535897932384626433832795
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+template <typename A, typename B> inline typename std::common_type<A, B>::type min(A a, B b) { return (a < b) ? a : b; }
+template <typename A, typename B> inline typename std::common_type<A, B>::type max(A a, B b) { return (a > b) ? a : b; }
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+typedef void *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+typedef int portMUX_TYPE;
+
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS 1
+#define portMAX_DELAY 0xFFFFFFFFUL
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+#define portMUX_INITIALIZER_UNLOCKED 0
+#define portENTER_CRITICAL(mux) ((void)(mux))                           // 1 thread: nothing to exclude
+#define portEXIT_CRITICAL(mux) ((void)(mux))
+
+inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t, const char *, uint32_t, void *, UBaseType_t, TaskHandle_t *task, BaseType_t)
+{
+    if(task != NULL)
+    {
+        *task = NULL;                                                   // Never started: renders are read back directly
+    }
+    return pdPASS;
+}
+inline TaskHandle_t xTaskGetCurrentTaskHandle() { return NULL; }
+inline void xTaskNotifyGive(TaskHandle_t) {}
+inline uint32_t ulTaskNotifyTake(BaseType_t, TickType_t) { return 0; }
+
+inline int64_t esp_timer_get_time()
+{
+    using namespace std::chrono;
+    return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+namespace HostLedc
+{
+    static uint32_t duty[16];                                           // Last `ledcWrite()` per channel
+}
+inline void ledcWrite(uint8_t channel, uint32_t duty) { HostLedc::duty[channel & 15] = duty; }
+inline uint32_t ledcRead(uint8_t channel) { return HostLedc::duty[channel & 15]; }
@@ -0,0 +1,119 @@
+/**
+ * Joel Brigida
+ * October 18, 2026
+ * Host stand-in for the Arduino-ESP32 `fs::FS` / `File` API (see `Arduino.h` here), backed
+ * by stdio, so SD code like `lib/SDBench` runs on a PC. Paths are relative to the root
+ * directory given to `fs::FS`, e.g. where a card reader is mounted. `flush()` also calls
+ * `fsync()`, like `f_sync()` on the ESP32 commits the data & the FAT entry.
+ */
+
+#pragma once
+
+#include "Arduino.h"
+#include <stdio.h>
+#include <string>
+#include <memory>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define FILE_READ   "r"
+#define FILE_WRITE  "w"
+#define FILE_APPEND "a"
+
+namespace fs
+{
+
+class File
+{
+public:
+    File() {}
+    explicit File(FILE *handle)
+    {
+        if(handle != NULL)
+        {
+            file.reset(handle, fclose);                                 // A failed `fopen()` must not reach `fclose()`
+        }
+    }
+
+    explicit operator bool() const
+    {
+        return file != nullptr;
+    }
+
+    size_t write(const uint8_t *data, size_t len)
+    {
+        return file ? fwrite(data, 1, len, file.get()) : 0;
+    }
+
+    size_t read(uint8_t *data, size_t len)
+    {
+        return file ? fread(data, 1, len, file.get()) : 0;
+    }
+
+    bool seek(uint32_t pos)
+    {
+        return file && fseek(file.get(), pos, SEEK_SET) == 0;
+    }
+
+    size_t size() const
+    {
+        struct stat info;
+        return (file && fstat(fileno(file.get()), &info) == 0) ? (size_t)info.st_size : 0;
+    }
+
+    void flush()
+    {
+        if(file)
+        {
+            fflush(file.get());
+            fsync(fileno(file.get()));
+        }
+    }
+
+    void close()
+    {
+        file.reset();
+    }
+
+private:
+    std::shared_ptr<FILE> file;                                         // Copies share 1 handle, like Arduino's `File`
+};
+
+class FS
+{
+public:
+    explicit FS(const std::string &rootDir) : root(rootDir) {}
+
+    File open(const char *path, const char *mode = FILE_READ)
+    {
+        std::string stdioMode = std::string(mode) + "b";
+        return File(fopen((root + path).c_str(), stdioMode.c_str()));
+    }
+
+    bool exists(const char *path)
+    {
+        return access((root + path).c_str(), F_OK) == 0;
+    }
+
+    bool mkdir(const char *path)
+    {
+        return ::mkdir((root + path).c_str(), 0755) == 0;
+    }
+
+    bool remove(const char *path)
+    {
+        return ::remove((root + path).c_str()) == 0;
+    }
+
+    bool rename(const char *from, const char *to)
+    {
+        return ::rename((root + from).c_str(), (root + to).c_str()) == 0;
+    }
+
+private:
+    std::string root;
+};
+
+}
+
+using fs::File;
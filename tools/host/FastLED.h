@@ -0,0 +1,62 @@
+/**
+ * Joel Brigida
+ * October 18, 2026
+ * Host stand-in for the FastLED types the LED render code uses (see `Arduino.h` here).
+ * `CRGB` keeps FastLED's layout (3 packed bytes: r, g, b) because the render code copies
+ * frames with `memcpy`. `show()` does nothing: the bench reads frames back from memory.
+ */
+
+#pragma once
+
+#include "Arduino.h"
+
+struct CRGB
+{
+    union
+    {
+        struct
+        {
+            uint8_t r;
+            uint8_t g;
+            uint8_t b;
+        };
+        uint8_t raw[3];
+    };
+
+    enum HTMLColorCode : uint32_t
+    {
+        Black = 0x000000,
+        Blue  = 0x0000FF,
+        Green = 0x008000,
+        Red   = 0xFF0000,
+        White = 0xFFFFFF
+    };
+
+    CRGB() {}
+    CRGB(uint8_t red, uint8_t green, uint8_t blue) : r(red), g(green), b(blue) {}
+    CRGB(HTMLColorCode code) : r((code >> 16) & 0xFF), g((code >> 8) & 0xFF), b(code & 0xFF) {}
+};
+
+static_assert(sizeof(CRGB) == 3, "frames are copied as packed r, g, b bytes");
+
+inline void fill_solid(CRGB *leds, int count, const CRGB &color)
+{
+    for(int i = 0; i < count; i++)
+    {
+        leds[i] = color;
+    }
+}
+
+struct CLEDController
+{
+    CLEDController &setLeds(CRGB *, int) { return *this; }
+};
+
+struct CFastLED
+{
+    void show(uint8_t) {}
+    void show() {}
+    void setBrightness(uint8_t) {}
+};
+
+static CFastLED FastLED;
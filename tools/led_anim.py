@@ -0,0 +1,124 @@
+#!/usr/bin/env python3
+"""
+Writes & inspects LED animation files for `play <file>` in 04-CLI-LEDs (see
+My-RTOS-Projects/04-CLI-LEDs/src/Animation.h for the format).
+
+Frames are rendered here, on the host, so the ESP32 only reads & copies them:
+    encode: raw RGB24 frames (e.g. `ffmpeg -i in.mp4 -vf scale=60:1 -f rawvideo -pix_fmt rgb24 out.rgb`)
+    demo:   a rainbow chase with a white comet, to test a strip & the SD read rate
+    info:   header, frame count & compression ratio of an existing file
+
+Usage:
+    python tools/led_anim.py encode frames.rgb show.led --leds 60 --fps 30 --rle
+    python tools/led_anim.py demo demo.led --leds 300 --fps 60 --seconds 20 --rle
+    python tools/led_anim.py info show.led
+Copy the .led file to the SD card & enter `play show.led` in the CLI.
+"""
+
+import argparse
+import colorsys
+import struct
+import sys
+
+MAGIC = b"LEDA"
+VERSION = 1
+RAW, RLE = 0, 1
+HEADER = struct.Struct("<4sBBHHHI")                                             # 16 bytes
+MAX_LEDS, MAX_FPS = 2048, 100
+
+
+def rle_frame(frame):
+    """[count 1-255, r, g, b] runs, prefixed with the uint16 byte count."""
+    out = bytearray()
+    i = 0
+    while i < len(frame):
+        pixel = frame[i:i + 3]
+        run = 1
+        while run < 255 and i + run * 3 < len(frame) and frame[i + run * 3:i + run * 3 + 3] == pixel:
+            run += 1
+        out += bytes([run]) + pixel
+        i += run * 3
+    return struct.pack("<H", len(out)) + out
+
+
+def write_animation(path, frames, leds, fps, rle):
+    if not 1 <= leds <= MAX_LEDS or not 1 <= fps <= MAX_FPS:
+        sys.exit("ERROR: LEDs must be 1 - %d & fps 1 - %d" % (MAX_LEDS, MAX_FPS))
+    count = 0
+    size = HEADER.size
+    with open(path, "wb") as out:
+        out.write(HEADER.pack(MAGIC, VERSION, RLE if rle else RAW, fps, leds, 0, 0))
+        for frame in frames:
+            data = rle_frame(frame) if rle else frame
+            out.write(data)
+            size += len(data)
+            count += 1
+        out.seek(0)
+        out.write(HEADER.pack(MAGIC, VERSION, RLE if rle else RAW, fps, leds, 0, count))
+    raw = HEADER.size + count * leds * 3
+    print("%d frames, %d LEDs @ %d fps -> %s: %d bytes (%.0f%% of raw), %.1f kB/s to play"
+          % (count, leds, fps, path, size, 100.0 * size / raw, (size - HEADER.size) / max(count, 1) * fps / 1024))
+
+
+def raw_frames(path, leds):
+    with open(path, "rb") as src:
+        while True:
+            frame = src.read(leds * 3)
+            if len(frame) < leds * 3:
+                return
+            yield frame
+
+
+def demo_frames(leds, fps, seconds):
+    for n in range(int(fps * seconds)):
+        t = n / fps
+        frame = bytearray()
+        comet = (t * leds / 2.0) % leds                                         # 2 seconds per pass
+        for i in range(leds):
+            r, g, b = colorsys.hsv_to_rgb((i / leds + t / 5.0) % 1.0, 1.0, 0.25)
+            tail = max(0.0, 1.0 - ((comet - i) % leds) / 8.0)                   # 8 LED tail behind the head
+            frame += bytes(int(min(1.0, c + tail) * 255) for c in (r, g, b))
+        yield bytes(frame)
+
+
+def info(path):
+    with open(path, "rb") as src:
+        data = src.read()
+    magic, version, encoding, fps, leds, _, frames = HEADER.unpack_from(data)
+    if magic != MAGIC or version != VERSION:
+        sys.exit("ERROR: not an animation file")
+    body = len(data) - HEADER.size
+    if encoding == RLE:
+        pos, counted = HEADER.size, 0
+        while pos + 2 <= len(data):
+            pos += 2 + struct.unpack_from("<H", data, pos)[0]
+            counted += 1
+    else:
+        counted = body // (leds * 3)
+    print("%s: %s, %d LEDs @ %d fps, %d frames (header says %d), %.1fs, %d bytes, %.1f kB/s to play"
+          % (path, "RLE" if encoding == RLE else "raw", leds, fps, counted, frames, counted / fps, body,
+             body / max(counted, 1) * fps / 1024))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("command", choices=("encode", "demo", "info"))
+    parser.add_argument("paths", nargs="+", help="encode: input output, demo: output, info: file")
+    parser.add_argument("--leds", type=int, default=60, help="LEDs per frame")
+    parser.add_argument("--fps", type=int, default=30, help="frames per second (max %d)" % MAX_FPS)
+    parser.add_argument("--seconds", type=float, default=10.0, help="demo length")
+    parser.add_argument("--rle", action="store_true", help="run-length encode frames")
+    args = parser.parse_args()
+
+    if args.command == "encode" and len(args.paths) == 2:
+        write_animation(args.paths[1], raw_frames(args.paths[0], args.leds), args.leds, args.fps, args.rle)
+    elif args.command == "demo" and len(args.paths) == 1:
+        write_animation(args.paths[0], demo_frames(args.leds, args.fps, args.seconds), args.leds, args.fps, args.rle)
+    elif args.command == "info" and len(args.paths) == 1:
+        info(args.paths[0])
+    else:
+        parser.error("wrong number of paths for %s" % args.command)
+
+
+if __name__ == "__main__":
+    main()
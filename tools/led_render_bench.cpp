@@ -0,0 +1,339 @@
+/**
+ * Joel Brigida
+ * October 18, 2026
+ * Host render benchmark & golden frame check for the LED patterns of 04-CLI-LEDs (`Patterns.cpp`)
+ * & the color wheel of 03-LED-RGB-color-wheel (`ColorWheel.h`), built with g++ against the
+ * stand-ins in `tools/host`. Every pattern renders into memory on a fixed 10ms clock:
+ *     1. Golden: the 1st 1000 frames of every scenario are hashed (FNV-1a over the LEDs,
+ *        brightness & Blue LED level) with a checkpoint every 100 frames & compared to
+ *        `tools/led_render_golden.txt`, so a mismatch also tells roughly when it went wrong.
+ *     2. Bench: once all goldens are done (patterns are singletons that keep their state, so
+ *        the goldens must not depend on `--frames`), more frames are timed: ns / frame & / LED.
+ * Build & run from the repo root:
+ *     g++ -O2 -std=gnu++11 -DLEDC_HW_FADE=0 -Itools/host -Ilib/LedTables/src -Ilib/LedcFade/src \
+ *         -IMy-RTOS-Projects/04-CLI-LEDs/src -IMy-RTOS-Projects/03-LED-RGB-color-wheel/src \
+ *         tools/led_render_bench.cpp My-RTOS-Projects/04-CLI-LEDs/src/Patterns.cpp -o led_render_bench
+ *     ./led_render_bench                     # check the goldens & time every pattern (300 LEDs)
+ *     ./led_render_bench --update            # rewrite this LED count's goldens after an intended change
+ *     ./led_render_bench --max-ns 50000      # also fail when any pattern is slower per frame
+ *     ./led_render_bench --golden FILE       # goldens elsewhere (default: `led_render_golden.txt` next to
+ *                                            # this source, as the path given to g++ says)
+ * Exit code 1 on a golden mismatch, a missing golden (file or scenario / LED count) or a blown
+ * `--max-ns` budget. Goldens are kept per LED count: a new `--leds N` needs `--update` 1st.
+ */
+
+#include <stdio.h>
+#include <vector>
+#include <string>
+#include "Patterns.h"                                                           // 04-CLI-LEDs
+#include "ColorWheel.h"                                                         // 03-LED-RGB-color-wheel
+
+static const uint32_t FrameUs = 10000;                                          // Same frame clock as the boards
+static const int GoldenFrames = 1000;
+static const int Checkpoint = 100;
+static const char GoldenFile[] = "led_render_golden.txt";                       // Next to this source file
+
+struct Scenario
+{
+    const char *name;
+    int pattern;                                                                // 04 pattern #, -1 = 03 color wheel
+    int crossfadeTo;                                                            // 0 = no crossfade
+};
+
+static const Scenario scenarios[] =
+{
+    { "04-pattern-1", 1, 0 },
+    { "04-pattern-2", 2, 0 },
+    { "04-pattern-3", 3, 0 },
+    { "04-pattern-4", 4, 0 },
+    { "04-pattern-5", 5, 0 },
+    { "04-off",       0, 0 },
+    { "04-xfade-1-3", 1, 3 },                                                   // 2 patterns + blend every frame
+    { "03-wheel",    -1, 0 }
+};
+
+struct Hasher                                                                   // FNV-1a, 32-bit
+{
+    uint32_t hash = 2166136261UL;
+
+    void add(const void *data, size_t len)
+    {
+        const uint8_t *bytes = (const uint8_t *)data;
+        for(size_t i = 0; i < len; i++)
+        {
+            hash = (hash ^ bytes[i]) * 16777619UL;
+        }
+    }
+};
+
+class Runner                                                                    // 1 scenario: render frames, read them back
+{
+public:
+    Runner(const Scenario &scenario, size_t leds)
+        : frames{ std::vector<CRGB>(leds, CRGB::Black), std::vector<CRGB>(leds, CRGB::Black) },
+          fades{ std::vector<CRGB>(leds, CRGB::Black), std::vector<CRGB>(leds, CRGB::Black) },
+          shown((scenario.pattern < 0) ? 1 : leds, CRGB::Black), strip(frames[0].data(), frames[1].data(), leds), output(strip, 0, 12),
+          crossfade(fades[0].data(), fades[1].data()), wheel(65), scenario(scenario)
+    {
+        capture.leds = shown.data();
+        if(scenario.pattern < 0)
+        {
+            return;
+        }
+        pattern = &patternFor(scenario.pattern);
+        pattern->setParams(PatternParams{ 5, 30, 250 });                        // 04 defaults
+        pattern->init(output);
+        if(scenario.crossfadeTo != 0)
+        {
+            LedPattern &next = patternFor(scenario.crossfadeTo);
+            next.setParams(PatternParams{ 5, 30, 250 });
+            for(int i = 0; i < 50; i++)                                         // Something on the LEDs to fade from
+            {
+                pattern->render(output, i, FrameUs);
+            }
+            crossfade.start(output, *pattern, next, 1000000);                   // Longer than any run: always blending
+            pattern = &next;
+        }
+    }
+
+    void render(uint32_t frame)
+    {
+        if(scenario.pattern < 0)
+        {
+            bright = wheel.render(FrameUs, 5, 30);
+            shown[0] = wheel.color;
+        }
+        else if(crossfade.active())
+        {
+            crossfade.render(output, frame, FrameUs);
+        }
+        else
+        {
+            pattern->render(output, frame, FrameUs);
+        }
+    }
+
+    void hashFrame(Hasher &hasher)
+    {
+        if(scenario.pattern >= 0)
+        {
+            output.snapshot(capture);                                           // What the LEDs would show now
+            bright = capture.bright;
+            blue = capture.blue;
+        }
+        hasher.add(shown.data(), shown.size() * sizeof(CRGB));
+        hasher.add(&bright, 1);
+        hasher.add(&blue, 1);
+    }
+
+private:
+    std::vector<CRGB> frames[2];
+    std::vector<CRGB> fades[2];
+    std::vector<CRGB> shown;
+    StripOutput strip;
+    LedOutput output;
+    Crossfade crossfade;
+    ColorWheel wheel;
+    FrameCapture capture;
+    LedPattern *pattern = NULL;
+    uint8_t bright = 0;
+    uint8_t blue = 0;
+    const Scenario &scenario;
+};
+
+static std::string goldenLine(const Scenario &scenario, Runner &runner, size_t leds)
+{
+    Hasher hasher;
+    char text[32];
+    std::string line = std::string(scenario.name) + " " + std::to_string(leds);
+    for(int frame = 0; frame < GoldenFrames; frame++)
+    {
+        runner.render(frame);
+        runner.hashFrame(hasher);
+        if((frame + 1) % Checkpoint == 0)
+        {
+            snprintf(text, sizeof(text), " %08x", hasher.hash);
+            line += text;
+        }
+    }
+    return line;
+}
+
+static std::string defaultGoldenPath()                                          // Next to this source, as the path given to g++ says
+{
+    std::string source = __FILE__;
+    return source.substr(0, source.find_last_of('/') + 1) + GoldenFile;         // No '/': npos + 1 = 0, the file name alone
+}
+
+static bool readGoldens(const std::string &path, std::vector<std::string> &lines) // false: file missing
+{
+    FILE *file = fopen(path.c_str(), "r");
+    if(file == NULL)
+    {
+        return false;
+    }
+    char text[256];
+    while(fgets(text, sizeof(text), file) != NULL)
+    {
+        text[strcspn(text, "\r\n")] = '\0';
+        if(text[0] != '#' && text[0] != '\0')
+        {
+            lines.push_back(text);
+        }
+    }
+    fclose(file);
+    return true;
+}
+
+static std::string goldenKey(const std::string &line)                           // Name & LED count
+{
+    return line.substr(0, line.find(' ', line.find(' ') + 1));
+}
+
+static int compareGolden(const std::string &line, const std::vector<std::string> &goldens) // 0 = match, 1 = mismatch, 2 = none
+{
+    std::string key = goldenKey(line);
+    for(const std::string &golden : goldens)
+    {
+        if(golden.compare(0, key.size() + 1, key + " ") != 0)
+        {
+            continue;
+        }
+        if(golden == line)
+        {
+            return 0;
+        }
+        size_t pos = key.size();
+        int checkpoint = 0;
+        while(pos < line.size() && line.compare(pos, 9, golden, pos, 9) == 0)   // Find the 1st differing checkpoint
+        {
+            pos += 9;
+            checkpoint++;
+        }
+        printf("  MISMATCH: output differs within frames %d - %d\n", checkpoint * Checkpoint + 1, (checkpoint + 1) * Checkpoint);
+        return 1;
+    }
+    return 2;
+}
+
+int main(int argc, char **argv)
+{
+    size_t leds = 300;
+    long benchFrames = 20000;
+    long maxNs = 0;
+    bool update = false;
+    std::string goldenPath = defaultGoldenPath();
+
+    for(int i = 1; i < argc; i++)
+    {
+        if(strcmp(argv[i], "--update") == 0)
+        {
+            update = true;
+        }
+        else if(strcmp(argv[i], "--leds") == 0 && i + 1 < argc)
+        {
+            leds = max(atoi(argv[++i]), 1);
+        }
+        else if(strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+        {
+            benchFrames = max(atol(argv[++i]), 1L);
+        }
+        else if(strcmp(argv[i], "--max-ns") == 0 && i + 1 < argc)
+        {
+            maxNs = atol(argv[++i]);
+        }
+        else if(strcmp(argv[i], "--golden") == 0 && i + 1 < argc)
+        {
+            goldenPath = argv[++i];
+        }
+        else
+        {
+            printf("Usage: %s [--leds N] [--frames N] [--max-ns N] [--golden FILE] [--update]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    std::vector<std::string> goldens;
+    std::vector<std::string> lines;
+    int failures = 0;
+    if(!readGoldens(goldenPath, goldens) && !update)                            // Nothing to compare against is a failure, not a pass
+    {
+        printf("Can't read %s: pass --golden <file>, or --update to create it\n", goldenPath.c_str());
+        failures++;
+    }
+
+    for(const Scenario &scenario : scenarios)                                   // Pass 1: goldens, always from the same state
+    {
+        Runner runner(scenario, leds);
+        lines.push_back(goldenLine(scenario, runner, leds));
+    }
+
+    printf("%-14s %12s %10s   golden (%zu LEDs, %d frames @ %ums)\n", "scenario", "ns / frame", "ns / LED", leds, GoldenFrames, FrameUs / 1000);
+    for(size_t n = 0; n < sizeof(scenarios) / sizeof(scenarios[0]); n++)       // Pass 2: timing
+    {
+        const Scenario &scenario = scenarios[n];
+        const std::string &line = lines[n];
+        Runner runner(scenario, leds);
+
+        int64_t start = esp_timer_get_time();
+        for(long frame = 0; frame < benchFrames; frame++)
+        {
+            runner.render(GoldenFrames + frame);
+        }
+        double ns = (esp_timer_get_time() - start) * 1000.0 / benchFrames;
+        size_t ledCount = (scenario.pattern < 0) ? 1 : leds;                    // 03 drives 1 LED
+
+        const char *result = "updated";
+        int compare = update ? -1 : compareGolden(line, goldens);
+        if(compare == 0)
+        {
+            result = "ok";
+        }
+        else if(compare == 1)
+        {
+            result = "MISMATCH";
+            failures++;
+        }
+        else if(compare == 2)
+        {
+            result = "NO GOLDEN";                                               // New scenario or `--leds`: `--update` records it
+            failures++;
+        }
+        printf("%-14s %12.0f %10.1f   %s\n", scenario.name, ns, ns / ledCount, result);
+        if(maxNs > 0 && ns > maxNs)
+        {
+            printf("  OVER BUDGET: %.0fns > %ldns per frame\n", ns, maxNs);
+            failures++;
+        }
+    }
+
+    if(update)
+    {
+        FILE *file = fopen(goldenPath.c_str(), "w");
+        if(file == NULL)
+        {
+            printf("Can't write %s: pass --golden <file>\n", goldenPath.c_str());
+            return 1;
+        }
+        fprintf(file, "# tools/led_render_bench.cpp goldens: scenario, LEDs, FNV-1a of frames 1-100, 1-200, ... 1-%d\n", GoldenFrames);
+        for(const std::string &golden : goldens)                                // Other LED counts stay as they were
+        {
+            bool replaced = false;
+            for(const std::string &line : lines)
+            {
+                replaced = replaced || goldenKey(golden) == goldenKey(line);
+            }
+            if(!replaced)
+            {
+                fprintf(file, "%s\n", golden.c_str());
+            }
+        }
+        for(const std::string &line : lines)
+        {
+            fprintf(file, "%s\n", line.c_str());
+        }
+        fclose(file);
+        printf("Wrote %s\n", goldenPath.c_str());
+    }
+    return (failures > 0) ? 1 : 0;
+}
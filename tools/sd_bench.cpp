@@ -0,0 +1,64 @@
+/**
+ * Joel Brigida
+ * October 18, 2026
+ * Host build of the `sdbench` command of 04-CLI-LEDs: the same `lib/SDBench` suite, run on
+ * a PC through the stdio stand-ins in `tools/host`. Point it at a card in a USB reader to
+ * compare a card before it goes into the ESP32, or at a local disk for a baseline. The
+ * card's speed is the same, but the host's cache & USB reader make reads look faster.
+ * Build & run from the repo root:
+ *     g++ -O2 -std=gnu++11 -Itools/host -Ilib/SDBench/src -Ilib/AppendLog/src tools/sd_bench.cpp -o sd_bench
+ *     ./sd_bench /media/$USER/SDCARD             # table to stdout, CSV in <dir>/bench/sdbench.csv
+ *     ./sd_bench /tmp --kb 4096                  # 4MB test file instead of 1MB
+ * Exit code 1 if any test failed (no space, card removed, ...).
+ */
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <vector>
+#include "SDBench.h"
+
+struct StdOut                                                                   // `out` for `SDBench::run()`
+{
+    __attribute__((format(printf, 2, 3)))
+    void printf(const char *format, ...)
+    {
+        va_list args;
+        va_start(args, format);
+        vprintf(format, args);
+        va_end(args);
+    }
+};
+
+int main(int argc, char **argv)
+{
+    const char *root = NULL;
+    uint32_t kB = 1024;
+
+    for(int i = 1; i < argc; i++)
+    {
+        if(strcmp(argv[i], "--kb") == 0 && i + 1 < argc)
+        {
+            kB = max(atoi(argv[++i]), 32);
+        }
+        else if(root == NULL && argv[i][0] != '-')
+        {
+            root = argv[i];
+        }
+        else
+        {
+            root = NULL;
+            break;
+        }
+    }
+    if(root == NULL)
+    {
+        printf("Usage: %s <dir> [--kb N]\n", argv[0]);
+        return 2;
+    }
+
+    fs::FS card(root);
+    SDBench bench(card, "/bench");
+    std::vector<uint8_t> buffer(SDBench::MAX_BLOCK);
+    StdOut out;
+    return bench.run(kB * 1024, buffer.data(), out) ? 0 : 1;
+}
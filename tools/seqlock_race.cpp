@@ -0,0 +1,143 @@
+/**
+ * Joel Brigida
+ * October 18, 2026
+ * Host race test for `lib/SeqLock`: 2 writer threads hammer 1 `SeqLock` while a reader
+ * thread takes snapshots, like `dispatchCommand()` on either core against the LED render
+ * loop. Every write fills all words of the value with the same number, so a snapshot whose
+ * words differ is torn. The reader also checks that `read()` versions never go backwards.
+ * `--unsafe` copies the value without the sequence check: torn snapshots show up at once,
+ * which proves the test can see them.
+ * Build & run from the repo root (the host `portENTER_CRITICAL()` is a no-op, so a mutex
+ * stands in for the ESP32 spinlock here):
+ *     g++ -O2 -std=gnu++11 -pthread -Itools/host -Ilib/SeqLock/src tools/seqlock_race.cpp -o seqlock_race
+ *     ./seqlock_race                  # 2 writers vs 1 reader for 1000ms
+ *     ./seqlock_race --ms 5000        # longer run
+ *     ./seqlock_race --unsafe         # plain copies: expect torn snapshots (exit code 1)
+ * Exit code 1 on a torn snapshot or a version that went backwards.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <mutex>
+#include <thread>
+#include "Arduino.h"
+
+static std::mutex hostLock;                                                     // 1 `SeqLock` in this test: 1 lock is enough
+#undef portENTER_CRITICAL
+#undef portEXIT_CRITICAL
+#define portENTER_CRITICAL(mux) ((void)(mux), hostLock.lock())
+#define portEXIT_CRITICAL(mux) ((void)(mux), hostLock.unlock())
+
+#include "SeqLock.h"
+
+struct Block                                                                    // Bigger than `LedParams`: a wider window to tear
+{
+    uint32_t words[16];
+};
+
+static Block filled(uint32_t value)
+{
+    Block block;
+    for(uint32_t &word : block.words)
+    {
+        word = value;
+    }
+    return block;
+}
+
+static bool torn(const Block &block)
+{
+    for(uint32_t word : block.words)
+    {
+        if(word != block.words[0])
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t runMs = 1000;
+    bool unsafe = false;
+
+    for(int i = 1; i < argc; i++)
+    {
+        if(strcmp(argv[i], "--ms") == 0 && i + 1 < argc)
+        {
+            runMs = atoi(argv[++i]);
+        }
+        else if(strcmp(argv[i], "--unsafe") == 0)
+        {
+            unsafe = true;
+        }
+        else
+        {
+            printf("Usage: %s [--ms N] [--unsafe]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    static SeqLock<Block> shared(filled(0));
+    std::atomic<bool> stop{false};
+    uint32_t writes[2] = {0, 0};
+
+    std::thread writers[2];
+    for(int w = 0; w < 2; w++)
+    {
+        writers[w] = std::thread([&, w]()
+        {
+            uint32_t value = (uint32_t)(w + 1) << 28;                           // Writers never write the same number
+            while(!stop.load(std::memory_order_relaxed))
+            {
+                value++;
+                shared.update([value](Block &block)
+                {
+                    for(uint32_t &word : block.words)
+                    {
+                        word = value;
+                    }
+                });
+                writes[w]++;
+            }
+        });
+    }
+
+    uint64_t reads = 0;
+    uint64_t tornReads = 0;
+    uint64_t backwards = 0;
+    uint32_t lastVersion = 0;
+    int64_t end = esp_timer_get_time() + (int64_t)runMs * 1000;
+    Block snapshot;
+
+    while(esp_timer_get_time() < end)
+    {
+        if(unsafe)
+        {
+            memcpy(&snapshot, (const void *)&shared, sizeof(snapshot));         // `value` is the 1st member: a plain racy copy
+        }
+        else
+        {
+            uint32_t version = shared.read(snapshot);
+            if(version < lastVersion)
+            {
+                backwards++;
+            }
+            lastVersion = version;
+        }
+        tornReads += torn(snapshot);
+        reads++;
+    }
+    stop = true;
+    for(std::thread &writer : writers)
+    {
+        writer.join();
+    }
+
+    printf("%s: %u + %u writes, %llu reads in %ums: %llu torn, %llu versions backwards, final version %u\n",
+           unsafe ? "unsafe copy" : "SeqLock", writes[0], writes[1], (unsigned long long)reads, runMs,
+           (unsigned long long)tornReads, (unsigned long long)backwards, shared.version());
+    return (tornReads == 0 && backwards == 0) ? 0 : 1;
+}